@@ -0,0 +1,78 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Animation.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Animation.h
+// Description: Play a list of frames on the IDL display.
+// Author:		Danon Bradford
+// Date:		2020-03-28
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Animation.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Animation_h
+#define Animation_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define Animation_MaxFrames         32
+#define Animation_DefaultFrameMs    100
+#define Animation_MinFrameMs        20
+
+//=============================================================================
+// Public Enumerated Constants
+//-----------------------------------------------------------------------------
+typedef enum {
+    Animation_Once = 0,         // Stop on the last frame
+    Animation_Loop = 1,         // Start again from the first frame
+    Animation_PingPong = 2      // Play forwards then backwards
+} Animation_Playback;
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+// A narrow frame is an 8x8 image in the U64 layout, drawn in the middle of the
+// display and turned with the display rotation.
+// A wide frame is the whole 12x8 display, 12 bits per display column with
+// column 0 in the low bits of Low. It is drawn as is.
+typedef struct {
+    uint64_t Low;
+    uint32_t High;
+    uint16_t DurationMs;
+    uint8_t Wide;
+} Animation_Frame_t;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+class AnimationClass {
+    public:
+    AnimationClass() {} // Constructor
+    static bool Load(const char *text);
+    static void Start();
+    static void Stop();
+    static bool IsPlaying() { return _TID != -1; }
+    static uint8_t FrameCount() { return _FrameCount; }
+
+    private:
+    static Animation_Frame_t _Frames[2][Animation_MaxFrames]; // The one playing and the next
+    static uint8_t _Active;
+    static uint8_t _FrameCount;
+    static uint8_t _Playback;
+    static uint8_t _Index;
+    static int8_t _Step;
+    static int _TID;
+    static void NextFrame();
+    static bool Advance();
+    static void Prepare();
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern AnimationClass Animation;
+
+#endif /* Animation_h */
+
+// Animation.h EOF
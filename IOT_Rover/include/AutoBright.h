@@ -0,0 +1,62 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH AutoBright.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	AutoBright.h
+// Description: Follow the ambient light with the display brightness.
+// Author:		Danon Bradford
+// Date:		2020-04-25
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH AutoBright.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef AutoBright_h
+#define AutoBright_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define AutoBright_Levels           16      // HT16K33 dimming levels
+#define AutoBright_DarkLux          5.0f    // Default curve, dimmest at or below
+#define AutoBright_BrightLux        1500.0f // Default curve, brightest at or above
+#define AutoBright_Hysteresis       1.15f   // Lux must pass a step by this ratio to change level
+#define AutoBright_LedMicroAmps     2500    // A lit LED at full brightness, 20 mA rows over 8 commons
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// The curve spaces the 16 levels evenly on a log lux scale between a dark and
+// a bright reading. Each lux sample moves the level at most one step, and only
+// once the reading is clear of the step by the hysteresis ratio.
+// The manual brightness is the ceiling, the display is only ever dimmed below it.
+class AutoBrightClass {
+    public:
+    AutoBrightClass() {} // Constructor
+    static void Enable(bool const onOff);
+    static bool Enabled() { return _Enabled; }
+    static void SetCurve(float const darkLux, float const brightLux);
+    static void SetManual(uint8_t const level);
+    static void Update(float const lux);
+    static void PrintStats();
+
+    private:
+    static bool _Enabled;
+    static float _Threshold[AutoBright_Levels - 1];
+    static uint8_t _Manual;
+    static uint8_t _Level;
+    static uint8_t _Issued;
+    static uint32_t _Changes;
+    static uint32_t _LastUpdateMs;
+    static float _SavedMah;
+    static float MicroAmps(uint8_t const level);
+    static void Issue();
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern AutoBrightClass AutoBright;
+
+#endif /* AutoBright_h */
+
+// AutoBright.h EOF
@@ -0,0 +1,73 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH BitMatrix.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	BitMatrix.h
+// Description: Transpose, flip and rotate an 8x8 bit image held in a uint64_t.
+// Author:		Danon Bradford
+// Date:		2020-03-21
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH BitMatrix.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef BitMatrix_h
+#define BitMatrix_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Byte n of the image is row n, bit n of a byte is column n, the same layout
+// as the display U64 images. Every operation works on all 64 bits at once with a few
+// shift and mask steps, there are no loops or lookup tables.
+class BitMatrix {
+
+    public:
+    BitMatrix() {} // Constructor
+
+    // Bit (row, col) moves to (col, row).
+    static inline uint64_t Transpose(uint64_t x) {
+        uint64_t t;
+        t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;     // 2x2 blocks
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;    // 4x4 blocks
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;    // 8x8 block
+        x = x ^ t ^ (t << 28);
+        return x;
+    }
+
+    // Reverse the order of the rows, bit (row, col) moves to (7 - row, col).
+    static inline uint64_t FlipRows(uint64_t x) {
+        x = ((x >> 8) & 0x00FF00FF00FF00FFull) | ((x & 0x00FF00FF00FF00FFull) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFull) | ((x & 0x0000FFFF0000FFFFull) << 16);
+        x = (x >> 32) | (x << 32);
+        return x;
+    }
+
+    // Reverse the bits in every row, bit (row, col) moves to (row, 7 - col).
+    static inline uint64_t FlipColumns(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+        x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+        return x;
+    }
+
+    // Bit (row, col) moves to (col, 7 - row).
+    static inline uint64_t Rotate90(uint64_t const x) {
+        return FlipColumns(Transpose(x));
+    }
+
+    // Bit (row, col) moves to (7 - row, 7 - col).
+    static inline uint64_t Rotate180(uint64_t const x) {
+        return FlipColumns(FlipRows(x));
+    }
+
+    // Bit (row, col) moves to (7 - col, row).
+    static inline uint64_t Rotate270(uint64_t const x) {
+        return FlipRows(Transpose(x));
+    }
+};
+
+#endif /* BitMatrix_h */
+
+// BitMatrix.h EOF
@@ -13,6 +13,19 @@
 // ----------------------------------------------------------------------------
 #include <stdint.h>
 
+//*****************************************************************************
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define DRV8830_MaxSpeed 57  // VSET steps above the lowest drive voltage
+
+// FAULT register bits
+#define DRV8830_FaultBit 0x01u     // FAULT, set with any of the other fault bits
+#define DRV8830_FaultOcp 0x02u     // Over current, the bridge is off until cleared
+#define DRV8830_FaultUvlo 0x04u    // Under voltage lockout
+#define DRV8830_FaultOts 0x08u     // Over temperature shutdown
+#define DRV8830_FaultILimit 0x10u  // The current limit cut the drive back
+#define DRV8830_FaultClear 0x80u   // Write to clear the fault bits
+
 //=============================================================================
 // Public Enumerated Constants
 //-----------------------------------------------------------------------------
@@ -33,6 +46,14 @@ typedef enum {
     DRV8830_Addr8 = 0x68u   // 104
 } DRV8830_Address;
 
+typedef enum {
+    DRV8830_Ocp = 0,
+    DRV8830_Uvlo,
+    DRV8830_Ots,
+    DRV8830_ILimit,
+    DRV8830_FaultKinds
+} DRV8830_FaultKind;
+
 typedef enum {
     DRV8830_Coast = 0x00u,
     DRV8830_Reverse = 0x01u,
@@ -43,22 +64,49 @@ typedef enum {
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
+// WriteControlReg only goes to the chip when the control value differs from
+// the last one the chip acknowledged. A failed write, a new address or a
+// cleared fault forget that value, so the next write always goes out.
 class DRV8830Class {
    private:
     uint8_t _I2CAddr;
     uint8_t _ControlReg;
+    uint8_t _AckedReg;
+    bool _AckedValid;
+    bool _FaultSeen;
+    uint32_t _WritesIssued;
+    uint32_t _WritesSuppressed;
+    uint32_t _FaultCounts[DRV8830_FaultKinds];
+    uint32_t _FaultMs;
+    uint8_t _LastFault;
     bool WriteRegByte(DRV8830_Register const reg, uint8_t const byte);
 
    public:
-    DRV8830Class(DRV8830_Address const addr) : _I2CAddr{addr} {}
+    DRV8830Class(DRV8830_Address const addr)
+        : _I2CAddr{addr}, _ControlReg{0}, _AckedReg{0}, _AckedValid{false},
+          _FaultSeen{false}, _WritesIssued{0}, _WritesSuppressed{0},
+          _FaultCounts{0, 0, 0, 0}, _FaultMs{0}, _LastFault{0} {}
     DRV8830Class() : DRV8830Class{DRV8830_Addr0} {}
-    void SetAddress(DRV8830_Address const addr) { _I2CAddr = addr; }
+    void SetAddress(DRV8830_Address const addr) {
+        _I2CAddr = addr;
+        _AckedValid = false;
+    }
     bool GetFaultReg(uint8_t *const dataPtr);
     bool ClearFaultReg();
+    bool FaultSeen() const { return _FaultSeen; }
+    uint32_t FaultCount(DRV8830_FaultKind const kind) const { return _FaultCounts[kind]; }
+    uint32_t FaultMs() const { return _FaultMs; }
+    uint8_t LastFault() const { return _LastFault; }
+    uint32_t WritesIssued() const { return _WritesIssued; }
+    uint32_t WritesSuppressed() const { return _WritesSuppressed; }
+    bool Driving() const {
+        return _AckedValid && ((_AckedReg & 0x03u) == DRV8830_Forward || (_AckedReg & 0x03u) == DRV8830_Reverse);
+    }
     void SetBridgeControl(DRV8830_BridgeLogic const data);
     void SetVoltage(uint8_t const speed);  // 0u <= speed <= 57u
     void SetSpeedDir(int8_t const speed);  // -57 <= speed <= 57
     void SetCoast();
+    void SetBrake();
     bool WriteControlReg();
 };
 
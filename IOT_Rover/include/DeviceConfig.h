@@ -69,6 +69,52 @@ typedef enum
     DC_Power_UploadThenDeepSleep = 1
 } DC_Power;
 
+// Sensor Sampling Rate Configuration
+// 00000000 000000XX X0000000 00000000
+#define DC_Rates_Pos  (DC_Power_Pos + DC_Power_Len)
+#define DC_Rates_Len  3
+typedef enum
+{
+    DC_Rates_Fixed = 0,
+    DC_Rates_Adaptive = 1,
+    DC_Rates_AdaptiveFast = 2
+} DC_Rates;
+
+// I2C Bus Clock Configuration
+// 00000000 000XXX00 00000000 00000000
+#define DC_I2C_Pos  (DC_Rates_Pos + DC_Rates_Len)
+#define DC_I2C_Len  3
+typedef enum
+{
+    DC_I2C_Standard100k = 0,
+    DC_I2C_Fast400k = 1
+} DC_I2C;
+
+// Display Panel Count Configuration, the number of chained HT16K33 panels less one
+// 00000000 XXX00000 00000000 00000000
+#define DC_Panels_Pos  (DC_I2C_Pos + DC_I2C_Len)
+#define DC_Panels_Len  3
+
+// Display Brightness Configuration
+// 00000XXX 00000000 00000000 00000000
+#define DC_Bright_Pos  (DC_Panels_Pos + DC_Panels_Len)
+#define DC_Bright_Len  3
+typedef enum
+{
+    DC_Bright_Manual = 0,
+    DC_Bright_AmbientLight = 1
+} DC_Bright;
+
+//=============================================================================
+// Product Config Code 2
+//-----------------------------------------------------------------------------
+
+// Display Panel Order
+// Nibble n is the I2C address less 0x70 of panel n, panel 0 is where the
+// scrolling text comes on. 0 keeps the panels in address order.
+// 0XXX0XXX 0XXX0XXX 0XXX0XXX 0XXX0XXX
+#define DC_PC2_Default  0x00000000
+
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
@@ -92,6 +138,11 @@ class DeviceConfigClass
     static DC_Enviro getEnviro();
     static DC_Analog getAnalog();
     static DC_Power getPower();
+    static DC_Rates getRates();
+    static DC_I2C getI2C();
+    static uint8_t getPanels();
+    static DC_Bright getBright();
+    static uint32_t getPanelOrder();
 
     private:
     static uint32_t ReverseBitsU32(uint32_t n);
@@ -24,20 +24,47 @@
 #define Display_String_Mode         4
 #define Display_U64_Mode            5
 #define Display_Manual_Mode         6
+#define Display_Animation_Mode      7
+#define Display_Stream_Mode         8
 
 #define Display_PRIMARY_Show 	    0
 #define Display_TEMPORARY_Show 	    1
 
+#define Display_Awake               0
+#define Display_Fading              1
+#define Display_Standby             2
+#define Display_FadeStepMs          60      // Time between brightness steps while fading out
+
+#define Display_U64Images           9       // 2 blank lead in images + 7
+#define Display_MaxStringLength     44
+#define Display_PanelWidth          12      // Columns along the scroll of one panel
+#define Display_LeadInExtra         4       // Blank columns before the message, past the canvas width
+#define Display_StripBytes          72      // 44 portrait glyphs and the lead in for 8 panels
+#define Display_StripBits           ((Display_StripBytes - 2) * 8)
+#define Display_StreamSize          128     // Characters waiting to be scrolled
+#define Display_StreamChunk         32      // Characters asked of a stream source at a time
+#define Display_StreamBitBytes      16      // Drawn stream columns, enough for 8 panels and a glyph
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+// Called when the streamed text runs out. Write up to size characters into
+// buffer and return how many were written, 0 if there is nothing to add.
+typedef uint8_t (*Display_StreamSourceFn)(char *const buffer, uint8_t const size);
+
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
 class DisplayClass {
     public:
     DisplayClass() {} // Constructor
+    static void SetPanels(uint8_t const count, uint32_t const order);
     static bool Init();
     static void UpdateRotation(uint8_t const rotation);
     static void SetMode(uint8_t const show, uint8_t const mode);
-    static void SetString(uint8_t const show, String textString);
+    static uint8_t GetMode(uint8_t const show) { return _Mode[show]; }
+    static void SetString(uint8_t const show, const char *text);
+    static void SetString(uint8_t const show, String const &textString) { SetString(show, textString.c_str()); }
     static void SetNumber(uint8_t const show, int const number);
     static void SetU64Image(uint8_t const show, uint64_t const image, uint8_t const index);
     static void SetU64Count(uint8_t const show, uint8_t const count);
@@ -49,29 +76,71 @@ class DisplayClass {
     static void ScrollEnable(bool const onOff);
     static void Clear();
     static void Invert();
+    static uint16_t LitPixels() { return _LightGrid.LitPixels(); }
+    static void SetIdleTimeout(uint32_t const seconds);
+    static void Wake();
+    static uint8_t IdleState() { return _IdleState; }
     static void SetPixel(uint8_t const x, uint8_t const y, uint8_t const onOff);
     static void SetAllPixelsOn();
     static void ManualWriteStringStart();
     static void WriteBuffer();
+    static void PrepareFrame(uint64_t const low, uint32_t const high, bool const wide);
+    static void CommitFrame();
+    static uint8_t StreamAppend(const char *text);
+    static uint8_t StreamAppend(const char *text, uint8_t const length);
+    static void StreamClear();
+    static void SetStreamSource(Display_StreamSourceFn const source);
+    static uint8_t StreamFree() { return Display_StreamSize - _StreamCount; }
 
     private:
     static LightGrid _LightGrid;    
     static int _DispUpdaTID;
     static int _TempStrTID;
+    static int _IdleTID;
+    static uint32_t _IdleTimeoutMs;
+    static uint8_t _IdleState;
+    static uint8_t _Brightness;
+    static uint8_t _FadeLevel;
+    static bool _ScrollWanted;
     static uint8_t _Mode[2];    // The PRIMARY and TEMPORARY modes. 
     static uint8_t _Show;       // Showing either PRIMARY or TEMPORARY.
     static uint8_t _Rotation;
     static uint8_t _StringCharArray[2][50];
     static uint8_t _StringLength[2];
-    static uint64_t _U64ImageArray[2][9];
+    static uint64_t _U64ImageArray[2][Display_U64Images];
     static uint8_t _U64ImageCount[2];
-    static uint8_t _ScrollElement;
-    static uint8_t _ScrollWindow;
-    static void LoadPartOfString(uint8_t const element, uint8_t const window);
+    static uint16_t _ScrollOffset;
+    static uint8_t _Width;
+    static uint8_t _LeadIn;
+    static uint8_t _Strip[8][Display_StripBytes];
+    static uint16_t _StripBits;
+    static uint16_t _StripEnd;
+    static uint8_t _StripShow;
+    static uint8_t _StripMode;
+    static uint8_t _StripRotation;
+    static bool _StripDirty;
+    static uint16_t _FrameNext[8];
+    static char _StreamRing[Display_StreamSize];
+    static uint8_t _StreamHead;
+    static uint8_t _StreamCount;
+    static Display_StreamSourceFn _StreamSource;
+    static uint8_t _StreamBits[8][Display_StreamBitBytes];
+    static uint8_t _StreamPos;
+    static uint8_t _StreamFill;
+    static uint8_t _StreamRotation;
+    static void LoadWindow(uint16_t offset);
     static void CheckActIfScrollEnabled();
     static void ScrollString();
     static void TempShowTimeout();
-    static void SetTrippleImage64(uint64_t const aa64, uint64_t const bb64, uint64_t const cc64, uint8_t leftShift);
+    static void RestartIdle();
+    static void IdleTimeout();
+    static void IdleFade();
+    static void UpdateStrip();
+    static void RenderStrip();
+    static uint8_t GlyphAdvance(uint8_t const index, bool const proportional);
+    static uint64_t OrientGlyph(uint64_t const image);
+    static void StreamTick(bool const advance);
+    static bool StreamPull();
 };
 
 //=============================================================================
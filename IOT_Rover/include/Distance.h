@@ -11,6 +11,8 @@
 
 #define DEFAULT_THRESHOLD 30
 #define DEFAULT_HYSTERESIS 4
+#define TOF_I2C_ADDRESS 0x29
+#define TOF_TIMING_BUDGET_US 20000 // One ranging in the high speed mode
 
 // Sensor library
 #include "Adafruit_VL53L0X.h"
@@ -20,12 +22,21 @@ class Distance : private Adafruit_VL53L0X
 public:
   Distance(); // Constructor
   uint8_t Init();
+  bool Poll();
+  void SetContinuous(bool continuous);
   uint16_t GetDistance();
   bool IsWithinThreshold();
   bool IsWithinRange();
+  void SetThreshold(uint16_t threshold, uint8_t hysteresis);
+  uint16_t LastDistance() const { return _distance; }
+  uint32_t ReadingUs() const { return _readingUs; }
 private:
-  void update();
-  VL53L0X_RangingMeasurementData_t _measure;
+  void update(uint16_t range);
+  bool _continuous;
+  bool _rangePending;
+  uint32_t _rangeStartUs;
+  uint32_t _emptyPollUs;
+  uint32_t _readingUs;
   uint16_t _distance;
   uint16_t _proximityThreshold;
   uint8_t _hysteresis;
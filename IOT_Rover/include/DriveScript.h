@@ -0,0 +1,104 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH DriveScript.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	DriveScript.h
+// Description: Run a timed list of moves on the rover, without the app.
+// Author:		Danon Bradford
+// Date:		2020-05-16
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH DriveScript.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef DriveScript_h
+#define DriveScript_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+#include "Mobility.h"				// Mobility Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define DriveScript_MaxBytes        128     // Longest script
+#define DriveScript_MaxDepth        4       // Loops inside loops
+#define DriveScript_MaxText         20      // Characters in one text step
+#define DriveScript_TextMs          3000    // How long a text step is shown
+#define DriveScript_StepBudget      64      // Steps run without a wait before the script is stopped
+
+//=============================================================================
+// Public Enumerated Constants
+//-----------------------------------------------------------------------------
+// Each step is an op code byte, then its operands.
+typedef enum {
+    DriveScript_End = 0x00,     // Stop the rover and end the script
+    DriveScript_Drive = 0x01,   // speed, steer, each a signed byte -100 to 100
+    DriveScript_Brake = 0x02,   // Brake both motors until the next drive
+    DriveScript_Wait = 0x03,    // ms, two bytes high first, 1 to 65535
+    DriveScript_Text = 0x04,    // length, then that many characters
+    DriveScript_Loop = 0x05,    // count, 0 for ever, runs to the matching Next
+    DriveScript_Next = 0x06     // Back to the step after the Loop
+} DriveScript_Op;
+
+typedef enum {
+    DriveScript_Idle = 0,
+    DriveScript_Running = 1,
+    DriveScript_Finished = 2,
+    DriveScript_Cancelled = 3,  // Stopped, or replaced by a new script
+    DriveScript_Overridden = 4, // A manual command took over
+    DriveScript_Obstacle = 5,   // The obstacle reflex braked
+    DriveScript_Runaway = 6     // Too many steps without a wait
+} DriveScript_State;
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+typedef struct {
+    uint8_t Start;              // The step after the Loop
+    uint8_t Remaining;          // Times still to run, 0 for ever
+} DriveScript_Loop_t;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// A whole script arrives as one line of hex, so that it is a single Vpin write,
+// or one Blynk HTTP API update. For example, forward for 1.5 s, spin for
+// 600 ms, brake, four times over:
+//   05 04  01 50 00  03 05DC  01 00 64  03 0258  02  03 00C8  06  00
+// Steps between waits run straight away. A wait is timed from when it was due,
+// not from when the timer ran, so a late timer does not push back the rest.
+// Motor setpoints take effect at the next control tick.
+// Any setpoint or stop from the app ends the script and takes over, and so
+// does the obstacle reflex braking, which leaves the rover braked.
+class DriveScriptClass {
+    public:
+    DriveScriptClass() {} // Constructor
+    static bool Load(const char *text);
+    static void Start();
+    static void Stop();
+    static bool IsRunning() { return _State == DriveScript_Running; }
+    static uint8_t State() { return _State; }
+    static void PrintStats();
+
+    private:
+    static uint8_t _Code[DriveScript_MaxBytes];
+    static uint8_t _Length;
+    static uint8_t _Pc;
+    static DriveScript_Loop_t _Loops[DriveScript_MaxDepth];
+    static uint8_t _Depth;
+    static uint8_t _State;
+    static int _TID;
+    static uint32_t _StartMs;
+    static uint32_t _DueMs;
+    static uint32_t _LateMaxMs;
+    static bool Check(uint8_t const *const code, uint8_t const length);
+    static void End(uint8_t const state);
+    static void Run();
+    static void Overridden(Mobility_Override const reason);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern DriveScriptClass DriveScript;
+
+#endif /* DriveScript_h */
+
+// DriveScript.h EOF
@@ -0,0 +1,62 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Font.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Font.h
+// Description: Proportional width font for the IDL display.
+// Author:		Danon Bradford
+// Date:		2020-04-04
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Font.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Font_h
+#define Font_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define Font_CacheSize      8       // Glyphs kept in RAM
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+// The font tables are made by tools/FontGen.cpp and live in flash, see FontData.h.
+// A glyph is only the columns it uses, one byte per column, bit n is row n.
+// Code points without a glyph are blank.
+typedef struct {
+    uint64_t Columns;   // Column n in byte n
+    uint8_t Code;
+    uint8_t Width;      // 0 for a blank glyph
+    uint8_t Left;       // Left bearing
+} Font_Cached_t;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+class FontClass {
+    public:
+    FontClass() {} // Constructor
+    static uint64_t Image(uint8_t const code, bool const bearing, uint8_t *const width);
+    static uint8_t Advance(uint8_t const code, uint8_t const next);
+    static uint32_t CacheHits;
+    static uint32_t CacheMisses;
+    static void PrintStats();
+
+    private:
+    static Font_Cached_t _Cache[Font_CacheSize];
+    static uint8_t _CacheCount;
+    static uint32_t _HitCycles;
+    static uint32_t _MissCycles;
+    static Font_Cached_t const* Lookup(uint8_t const code);
+    static void Load(uint8_t const code, Font_Cached_t *const entry);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern FontClass Font;
+
+#endif /* Font_h */
+
+// Font.h EOF
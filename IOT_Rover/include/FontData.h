@@ -0,0 +1,290 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH FontData.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	FontData.h
+// Description: Proportional display font, made by tools/FontGen.cpp. Do not edit.
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH FontData.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef FontData_h
+#define FontData_h
+
+#include "Font.h"					// Font Header file
+
+// 126 glyphs, 760 column bytes, 5 ranges.
+#define Font_GlyphCount     126
+#define Font_RangeCount     5
+#define Font_Kerning        1
+#define Font_Spacing        1
+#define Font_SpaceAdvance   3
+
+#define Font_ColumnBytes    768
+
+const uint8_t FontColumns[Font_ColumnBytes] PROGMEM __attribute__((aligned(4))) = {
+    0x5f, 0x5f,                                            //  33 = !
+    0x07, 0x07, 0x00, 0x07, 0x07,                          //  34 = "
+    0x14, 0x7f, 0x7f, 0x14, 0x7f, 0x7f, 0x14,              //  35 = #
+    0x24, 0x2e, 0x6b, 0x6b, 0x3a, 0x12,                    //  36 = $
+    0x46, 0x66, 0x30, 0x18, 0x0c, 0x66, 0x62,              //  37 = %
+    0x30, 0x7a, 0x4f, 0x5d, 0x37, 0x7a, 0x48,              //  38 = &
+    0x04, 0x07, 0x03,                                      //  39 = '
+    0x1c, 0x3e, 0x63, 0x41,                                //  40 = (
+    0x41, 0x63, 0x3e, 0x1c,                                //  41 = )
+    0x08, 0x2a, 0x3e, 0x1c, 0x1c, 0x3e, 0x2a, 0x08,        //  42 = *
+    0x08, 0x08, 0x3e, 0x3e, 0x08, 0x08,                    //  43 = +
+    0x80, 0xe0, 0x60,                                      //  44 = ,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08,                    //  45 = -
+    0x60, 0x60,                                            //  46 = .
+    0x60, 0x30, 0x18, 0x0c, 0x06, 0x03, 0x01,              //  47 = /
+    0x3e, 0x7f, 0x71, 0x59, 0x4d, 0x7f, 0x3e,              //  48 = 0
+    0x40, 0x42, 0x7f, 0x7f, 0x40, 0x40,                    //  49 = 1
+    0x62, 0x73, 0x59, 0x49, 0x6f, 0x66,                    //  50 = 2
+    0x22, 0x63, 0x49, 0x49, 0x7f, 0x36,                    //  51 = 3
+    0x18, 0x1c, 0x16, 0x53, 0x7f, 0x7f, 0x50,              //  52 = 4
+    0x27, 0x67, 0x45, 0x45, 0x7d, 0x39,                    //  53 = 5
+    0x3c, 0x7e, 0x4b, 0x49, 0x79, 0x30,                    //  54 = 6
+    0x03, 0x03, 0x71, 0x79, 0x0f, 0x07,                    //  55 = 7
+    0x36, 0x7f, 0x49, 0x49, 0x7f, 0x36,                    //  56 = 8
+    0x06, 0x4f, 0x49, 0x69, 0x3f, 0x1e,                    //  57 = 9
+    0x66, 0x66,                                            //  58 = :
+    0x80, 0xe6, 0x66,                                      //  59 = ;
+    0x08, 0x1c, 0x36, 0x63, 0x41,                          //  60 = <
+    0x24, 0x24, 0x24, 0x24, 0x24, 0x24,                    //  61 = =
+    0x41, 0x63, 0x36, 0x1c, 0x08,                          //  62 = >
+    0x02, 0x03, 0x51, 0x59, 0x0f, 0x06,                    //  63 = ?
+    0x3e, 0x7f, 0x41, 0x5d, 0x5d, 0x1f, 0x1e,              //  64 = @
+    0x7c, 0x7e, 0x13, 0x13, 0x7e, 0x7c,                    //  65 = A
+    0x41, 0x7f, 0x7f, 0x49, 0x49, 0x7f, 0x36,              //  66 = B
+    0x1c, 0x3e, 0x63, 0x41, 0x41, 0x63, 0x22,              //  67 = C
+    0x41, 0x7f, 0x7f, 0x41, 0x63, 0x3e, 0x1c,              //  68 = D
+    0x41, 0x7f, 0x7f, 0x49, 0x5d, 0x41, 0x63,              //  69 = E
+    0x41, 0x7f, 0x7f, 0x49, 0x1d, 0x01, 0x03,              //  70 = F
+    0x1c, 0x3e, 0x63, 0x41, 0x51, 0x73, 0x72,              //  71 = G
+    0x7f, 0x7f, 0x08, 0x08, 0x7f, 0x7f,                    //  72 = H
+    0x41, 0x7f, 0x7f, 0x41,                                //  73 = I
+    0x30, 0x70, 0x40, 0x41, 0x7f, 0x3f, 0x01,              //  74 = J
+    0x41, 0x7f, 0x7f, 0x08, 0x1c, 0x77, 0x63,              //  75 = K
+    0x41, 0x7f, 0x7f, 0x41, 0x40, 0x60, 0x70,              //  76 = L
+    0x7f, 0x7f, 0x0e, 0x1c, 0x0e, 0x7f, 0x7f,              //  77 = M
+    0x7f, 0x7f, 0x06, 0x0c, 0x18, 0x7f, 0x7f,              //  78 = N
+    0x1c, 0x3e, 0x63, 0x41, 0x63, 0x3e, 0x1c,              //  79 = O
+    0x41, 0x7f, 0x7f, 0x49, 0x09, 0x0f, 0x06,              //  80 = P
+    0x1e, 0x3f, 0x21, 0x71, 0x7f, 0x5e,                    //  81 = Q
+    0x41, 0x7f, 0x7f, 0x09, 0x19, 0x7f, 0x66,              //  82 = R
+    0x26, 0x6f, 0x4d, 0x59, 0x73, 0x32,                    //  83 = S
+    0x03, 0x41, 0x7f, 0x7f, 0x41, 0x03,                    //  84 = T
+    0x7f, 0x7f, 0x40, 0x40, 0x7f, 0x7f,                    //  85 = U
+    0x1f, 0x3f, 0x60, 0x60, 0x3f, 0x1f,                    //  86 = V
+    0x7f, 0x7f, 0x30, 0x18, 0x30, 0x7f, 0x7f,              //  87 = W
+    0x43, 0x67, 0x3c, 0x18, 0x3c, 0x67, 0x43,              //  88 = X
+    0x07, 0x4f, 0x78, 0x78, 0x4f, 0x07,                    //  89 = Y
+    0x47, 0x63, 0x71, 0x59, 0x4d, 0x67, 0x73,              //  90 = Z
+    0x7f, 0x7f, 0x41, 0x41,                                //  91 = [
+    0x01, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60,              //  92 = back slash
+    0x41, 0x41, 0x7f, 0x7f,                                //  93 = ]
+    0x08, 0x0c, 0x06, 0x03, 0x06, 0x0c, 0x08,              //  94 = ^
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80,                    //  95 = _
+    0x03, 0x07, 0x04,                                      //  96 = `
+    0x20, 0x74, 0x54, 0x54, 0x3c, 0x78, 0x40,              //  97 = a
+    0x41, 0x7f, 0x3f, 0x48, 0x48, 0x78, 0x30,              //  98 = b
+    0x38, 0x7c, 0x44, 0x44, 0x6c, 0x28,                    //  99 = c
+    0x30, 0x78, 0x48, 0x49, 0x3f, 0x7f, 0x40,              // 100 = d
+    0x38, 0x7c, 0x54, 0x54, 0x5c, 0x18,                    // 101 = e
+    0x48, 0x7e, 0x7f, 0x49, 0x03, 0x02,                    // 102 = f
+    0x98, 0xbc, 0xa4, 0xa4, 0xf8, 0x7c, 0x04,              // 103 = g
+    0x41, 0x7f, 0x7f, 0x08, 0x04, 0x7c, 0x78,              // 104 = h
+    0x44, 0x7d, 0x7d, 0x40,                                // 105 = i
+    0x60, 0xe0, 0x80, 0x80, 0xfd, 0x7d,                    // 106 = j
+    0x41, 0x7f, 0x7f, 0x10, 0x38, 0x6c, 0x44,              // 107 = k
+    0x41, 0x7f, 0x7f, 0x40,                                // 108 = l
+    0x7c, 0x7c, 0x18, 0x38, 0x1c, 0x7c, 0x78,              // 109 = m
+    0x7c, 0x7c, 0x04, 0x04, 0x7c, 0x78,                    // 110 = n
+    0x38, 0x7c, 0x44, 0x44, 0x7c, 0x38,                    // 111 = o
+    0x84, 0xfc, 0xf8, 0xa4, 0x24, 0x3c, 0x18,              // 112 = p
+    0x18, 0x3c, 0x24, 0xa4, 0xf8, 0xfc, 0x84,              // 113 = q
+    0x44, 0x7c, 0x78, 0x4c, 0x04, 0x1c, 0x18,              // 114 = r
+    0x48, 0x5c, 0x54, 0x54, 0x74, 0x24,                    // 115 = s
+    0x04, 0x3e, 0x7f, 0x44, 0x24,                          // 116 = t
+    0x3c, 0x7c, 0x40, 0x40, 0x3c, 0x7c, 0x40,              // 117 = u
+    0x1c, 0x3c, 0x60, 0x60, 0x3c, 0x1c,                    // 118 = v
+    0x3c, 0x7c, 0x70, 0x38, 0x70, 0x7c, 0x3c,              // 119 = w
+    0x44, 0x6c, 0x38, 0x10, 0x38, 0x6c, 0x44,              // 120 = x
+    0x9c, 0xbc, 0xa0, 0xa0, 0xfc, 0x7c,                    // 121 = y
+    0x4c, 0x64, 0x74, 0x5c, 0x4c, 0x64,                    // 122 = z
+    0x08, 0x08, 0x3e, 0x77, 0x41, 0x41,                    // 123 = {
+    0x7f,                                                  // 124 = |
+    0x41, 0x41, 0x77, 0x3e, 0x08, 0x08,                    // 125 = }
+    0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01,              // 126 = ~
+    0x73, 0x73,                                            // 161 = 0xA1
+    0x18, 0x3c, 0x24, 0xe7, 0xe7, 0x24, 0x24,              // 162 = 0xA2
+    0x68, 0x7e, 0x7f, 0x49, 0x43, 0x66, 0x20,              // 163 = 0xA3
+    0x2a, 0x1c, 0x36, 0x36, 0x1c, 0x2a,                    // 164 = 0xA4
+    0x2b, 0x2f, 0xfc, 0xfc, 0x2f, 0x2b,                    // 165 = 0xA5
+    0xe7, 0xe7,                                            // 166 = 0xA6
+    0x40, 0xda, 0xbf, 0xa5, 0xfd, 0x59, 0x03, 0x02,        // 167 = 0xA7
+    0x01, 0x01, 0x00, 0x00, 0x01, 0x01,                    // 168 = 0xA8
+    0x3c, 0x42, 0x99, 0xa5, 0xa5, 0x81, 0x42, 0x3c,        // 169 = 0xA9
+    0x08, 0x1d, 0x15, 0x15, 0x1f, 0x1e, 0x10,              // 170 = 0xAA
+    0x08, 0x1c, 0x36, 0x22, 0x08, 0x1c, 0x36, 0x22,        // 171 = 0xAB
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x30,                    // 172 = 0xAC
+    0x3c, 0x42, 0xbd, 0x95, 0x95, 0xa9, 0x42, 0x3c,        // 174 = 0xAE
+    0x01, 0x01, 0x01, 0x01, 0x01,                          // 175 = 0xAF
+    0x06, 0x0f, 0x09, 0x0f, 0x06,                          // 176 = 0xB0
+    0x44, 0x44, 0x5f, 0x5f, 0x44, 0x44,                    // 177 = 0xB1
+    0x19, 0x1d, 0x17, 0x12,                                // 178 = 0xB2
+    0x11, 0x15, 0x1f, 0x0a,                                // 179 = 0xB3
+    0x80, 0xfc, 0x7c, 0x20, 0x20, 0x3c, 0x1c,              // 181 = 0xB5
+    0x06, 0x0f, 0x09, 0x7f, 0x7f, 0x01, 0x7f, 0x7f,        // 182 = 0xB6
+    0x0a, 0x0f, 0x08,                                      // 185 = 0xB9
+    0x26, 0x2f, 0x29, 0x2f, 0x26,                          // 186 = 0xBA
+    0x22, 0x36, 0x1c, 0x08, 0x22, 0x36, 0x1c, 0x08,        // 187 = 0xBB
+    0x0f, 0x4f, 0x60, 0x30, 0x18, 0x6c, 0x56, 0xfa,        // 188 = 0xBC
+    0x4f, 0x6f, 0x30, 0x18, 0xcc, 0xee, 0xbb, 0x91,        // 189 = 0xBD
+    0x15, 0x55, 0x6a, 0x30, 0x18, 0x6c, 0x56, 0xfa,        // 190 = 0xBE
+    0x30, 0x78, 0x4d, 0x45, 0x60, 0x20,                    // 191 = 0xBF
+    0x71, 0x79, 0x2d, 0x24, 0x2c, 0x78, 0x70,              // 192 = 0xC0
+    0x70, 0x78, 0x2c, 0x24, 0x2d, 0x79, 0x71,              // 193 = 0xC1
+    0x70, 0x7a, 0x2b, 0x29, 0x2b, 0x7a, 0x70,              // 194 = 0xC2
+    0x72, 0x7b, 0x29, 0x2b, 0x2a, 0x7b, 0x71,              // 195 = 0xC3
+    0x79, 0x7d, 0x16, 0x12, 0x16, 0x7d, 0x79,              // 196 = 0xC4
+};
+
+// Column offset in bits 0-15, width in bits 16-19, left bearing in bits 20-23.
+const uint32_t FontGlyphs[Font_GlyphCount] PROGMEM = {
+    0x00220000,                         //  33 = !
+    0x00150002,                         //  34 = "
+    0x00070007,                         //  35 = #
+    0x0006000e,                         //  36 = $
+    0x00070014,                         //  37 = %
+    0x0007001b,                         //  38 = &
+    0x00030022,                         //  39 = '
+    0x00140025,                         //  40 = (
+    0x00140029,                         //  41 = )
+    0x0008002d,                         //  42 = *
+    0x00060035,                         //  43 = +
+    0x0013003b,                         //  44 = ,
+    0x0006003e,                         //  45 = -
+    0x00220044,                         //  46 = .
+    0x00070046,                         //  47 = /
+    0x0007004d,                         //  48 = 0
+    0x00060054,                         //  49 = 1
+    0x0006005a,                         //  50 = 2
+    0x00060060,                         //  51 = 3
+    0x00070066,                         //  52 = 4
+    0x0006006d,                         //  53 = 5
+    0x00060073,                         //  54 = 6
+    0x00060079,                         //  55 = 7
+    0x0006007f,                         //  56 = 8
+    0x00060085,                         //  57 = 9
+    0x0022008b,                         //  58 = :
+    0x0013008d,                         //  59 = ;
+    0x00050090,                         //  60 = <
+    0x00060095,                         //  61 = =
+    0x0015009b,                         //  62 = >
+    0x000600a0,                         //  63 = ?
+    0x000700a6,                         //  64 = @
+    0x000600ad,                         //  65 = A
+    0x000700b3,                         //  66 = B
+    0x000700ba,                         //  67 = C
+    0x000700c1,                         //  68 = D
+    0x000700c8,                         //  69 = E
+    0x000700cf,                         //  70 = F
+    0x000700d6,                         //  71 = G
+    0x000600dd,                         //  72 = H
+    0x001400e3,                         //  73 = I
+    0x000700e7,                         //  74 = J
+    0x000700ee,                         //  75 = K
+    0x000700f5,                         //  76 = L
+    0x000700fc,                         //  77 = M
+    0x00070103,                         //  78 = N
+    0x0007010a,                         //  79 = O
+    0x00070111,                         //  80 = P
+    0x00060118,                         //  81 = Q
+    0x0007011e,                         //  82 = R
+    0x00060125,                         //  83 = S
+    0x0006012b,                         //  84 = T
+    0x00060131,                         //  85 = U
+    0x00060137,                         //  86 = V
+    0x0007013d,                         //  87 = W
+    0x00070144,                         //  88 = X
+    0x0006014b,                         //  89 = Y
+    0x00070151,                         //  90 = Z
+    0x00140158,                         //  91 = [
+    0x0007015c,                         //  92 = back slash
+    0x00140163,                         //  93 = ]
+    0x00070167,                         //  94 = ^
+    0x0006016e,                         //  95 = _
+    0x00230174,                         //  96 = `
+    0x00070177,                         //  97 = a
+    0x0007017e,                         //  98 = b
+    0x00060185,                         //  99 = c
+    0x0007018b,                         // 100 = d
+    0x00060192,                         // 101 = e
+    0x00060198,                         // 102 = f
+    0x0007019e,                         // 103 = g
+    0x000701a5,                         // 104 = h
+    0x001401ac,                         // 105 = i
+    0x000601b0,                         // 106 = j
+    0x000701b6,                         // 107 = k
+    0x001401bd,                         // 108 = l
+    0x000701c1,                         // 109 = m
+    0x000601c8,                         // 110 = n
+    0x000601ce,                         // 111 = o
+    0x000701d4,                         // 112 = p
+    0x000701db,                         // 113 = q
+    0x000701e2,                         // 114 = r
+    0x000601e9,                         // 115 = s
+    0x001501ef,                         // 116 = t
+    0x000701f4,                         // 117 = u
+    0x000601fb,                         // 118 = v
+    0x00070201,                         // 119 = w
+    0x00070208,                         // 120 = x
+    0x0006020f,                         // 121 = y
+    0x00060215,                         // 122 = z
+    0x0006021b,                         // 123 = {
+    0x00310221,                         // 124 = |
+    0x00060222,                         // 125 = }
+    0x00070228,                         // 126 = ~
+    0x0022022f,                         // 161 = 0xA1
+    0x00070231,                         // 162 = 0xA2
+    0x00070238,                         // 163 = 0xA3
+    0x0016023f,                         // 164 = 0xA4
+    0x00060245,                         // 165 = 0xA5
+    0x0022024b,                         // 166 = 0xA6
+    0x0008024d,                         // 167 = 0xA7
+    0x00060255,                         // 168 = 0xA8
+    0x0008025b,                         // 169 = 0xA9
+    0x00070263,                         // 170 = 0xAA
+    0x0008026a,                         // 171 = 0xAB
+    0x00060272,                         // 172 = 0xAC
+    0x00080278,                         // 174 = 0xAE
+    0x00150280,                         // 175 = 0xAF
+    0x00150285,                         // 176 = 0xB0
+    0x0016028a,                         // 177 = 0xB1
+    0x00240290,                         // 178 = 0xB2
+    0x00240294,                         // 179 = 0xB3
+    0x00070298,                         // 181 = 0xB5
+    0x0008029f,                         // 182 = 0xB6
+    0x002302a7,                         // 185 = 0xB9
+    0x001502aa,                         // 186 = 0xBA
+    0x000802af,                         // 187 = 0xBB
+    0x000802b7,                         // 188 = 0xBC
+    0x000802bf,                         // 189 = 0xBD
+    0x000802c7,                         // 190 = 0xBE
+    0x000602cf,                         // 191 = 0xBF
+    0x000702d5,                         // 192 = 0xC0
+    0x000702dc,                         // 193 = 0xC1
+    0x000702e3,                         // 194 = 0xC2
+    0x000702ea,                         // 195 = 0xC3
+    0x000702f1,                         // 196 = 0xC4
+};
+
+// First code point in bits 0-7, count in bits 8-15, first glyph in bits 16-23.
+const uint32_t FontRanges[Font_RangeCount] PROGMEM = {
+    0x00005e21,                         //  33 - 126
+    0x005e0ca1,                         // 161 - 172
+    0x006a06ae,                         // 174 - 179
+    0x007002b5,                         // 181 - 182
+    0x00720cb9,                         // 185 - 196
+};
+
+#endif /* FontData_h */
+
+// FontData.h EOF
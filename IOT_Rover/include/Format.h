@@ -0,0 +1,54 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Format.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Format.h
+// Description: Number to text and text to number, into fixed buffers.
+// Author:		Danon Bradford
+// Date:		2020-04-18
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Format.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Format_h
+#define Format_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define Format_NumberSize   12      // Enough for any int32_t and its terminator
+
+// Unit suffixes, the degree sign is code point 176 in the display font.
+#define Format_DegreesC     "\xB0" "C"
+#define Format_Percent      "%"
+#define Format_Volts        "V"
+#define Format_Lux          "lx"
+#define Format_Millimetres  "mm"
+#define Format_Steps        " steps"
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Every Append method writes at buffer[length] and returns the new length, so
+// calls chain one after the other into the same buffer. Text that does not
+// fit is cut short, the buffer always ends with a terminator. No heap is used.
+class FormatClass {
+    public:
+    FormatClass() {} // Constructor
+    static uint8_t Text(char *const buffer, uint8_t const size, uint8_t length, const char *text);
+    static uint8_t Unsigned(char *const buffer, uint8_t const size, uint8_t const length, uint32_t value);
+    static uint8_t Int(char *const buffer, uint8_t const size, uint8_t length, int32_t const value);
+    static uint8_t Fixed(char *const buffer, uint8_t const size, uint8_t length, float const value, uint8_t const decimals);
+    static uint8_t Hex(char *const buffer, uint8_t const size, uint8_t const length, uint32_t value, uint8_t const digits);
+    static int8_t HexDigit(char const c);
+    static bool ParseHex(const char *text, uint8_t const digits, uint64_t *const value);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern FormatClass Format;
+
+#endif /* Format_h */
+
+// Format.h EOF
@@ -0,0 +1,134 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH I2CBus.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	I2CBus.h
+// Description: Prioritised transaction queue for the shared I2C bus.
+// Author:		Danon Bradford
+// Date:		2020-03-14
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH I2CBus.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef I2CBus_h
+#define I2CBus_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define I2CBus_TxInlineMax      4   // Bytes copied into a transaction
+#define I2CBus_QueueDepth       8   // Queued transactions per priority
+#define I2CBus_StatsCount       16  // Devices that can be tracked, and checked by Begin
+#define I2CBus_ProfileWindow    1000 // ms over which the duty cycle is measured
+#define I2CBus_Standard         100000
+#define I2CBus_Fast             400000
+
+//=============================================================================
+// Public Enumerated Constants
+//-----------------------------------------------------------------------------
+typedef enum {
+    I2CBus_Write = 0,       // Write the inline bytes
+    I2CBus_WriteRead = 1,   // Write the inline bytes, repeated start, read RxLen bytes
+    I2CBus_Burst = 2        // Write the inline bytes followed by a caller owned block
+} I2CBus_Type;
+
+// Lower numbers are more urgent.
+typedef enum {
+    I2CBus_PriorityMotor = 0,
+    I2CBus_PriorityTof = 1,
+    I2CBus_PriorityAccel = 2,
+    I2CBus_PriorityDisplay = 3,
+    I2CBus_PriorityCount = 4
+} I2CBus_Priority;
+
+// 0 to 4 are the Wire.endTransmission() results.
+typedef enum {
+    I2CBus_Ok = 0,
+    I2CBus_TooLong = 1,
+    I2CBus_NackAddr = 2,
+    I2CBus_NackData = 3,
+    I2CBus_BusError = 4,
+    I2CBus_ReadShort = 5,
+    I2CBus_Idle = 0xFE,
+    I2CBus_Pending = 0xFF
+} I2CBus_Status;
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+typedef struct I2CBus_Trans_s I2CBus_Trans_t;
+typedef void (*I2CBus_CallbackFn)(I2CBus_Trans_t *const trans);
+
+// A transaction descriptor is owned by the caller. A queued descriptor must
+// stay valid until it completes. Submitting it again while it is still pending
+// does not queue it twice, the latest contents are used when it runs.
+struct I2CBus_Trans_s {
+    uint8_t Addr;
+    uint8_t Type;
+    uint8_t Priority;
+    volatile uint8_t Status;
+    uint8_t TxData[I2CBus_TxInlineMax];
+    uint8_t TxLen;
+    uint8_t BurstLen;
+    const uint8_t* BurstPtr;
+    uint8_t* RxPtr;
+    uint8_t RxLen;
+    I2CBus_CallbackFn Callback;
+    void* Context;
+};
+
+typedef struct {
+    uint8_t Addr;
+    uint32_t Transactions;
+    uint32_t Bytes;
+    uint32_t Errors;
+    uint32_t Nacks;
+    uint32_t BusyUs;
+} I2CBus_Stats_t;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+class I2CBusClass {
+    public:
+    I2CBusClass() {} // Constructor
+    static bool Begin(bool const fastMode, uint8_t const *const addrs, uint8_t const count);
+    static void Init(I2CBus_Trans_t *const trans, uint8_t const addr,
+                     I2CBus_Type const type, I2CBus_Priority const priority);
+    static bool Submit(I2CBus_Trans_t *const trans);
+    static bool Transact(I2CBus_Trans_t *const trans);
+    static void Flush(uint8_t const priority = I2CBus_PriorityCount);
+    static void Run();
+    static uint8_t Pending();
+    static uint8_t Room(uint8_t const priority);
+    static bool Probe(uint8_t const addr);
+    static void Account(uint8_t const addr, uint32_t const busyUs, bool const ok);
+    static uint32_t Dropped;
+    static uint32_t ClockHz;
+    static uint16_t DutyPermille();
+    static const I2CBus_Stats_t* GetStats(uint8_t const index);
+    static void PrintStats();
+
+    private:
+    static I2CBus_Trans_t* _Queue[I2CBus_PriorityCount][I2CBus_QueueDepth];
+    static uint8_t _QueueHead[I2CBus_PriorityCount];
+    static uint8_t _QueueCount[I2CBus_PriorityCount];
+    static I2CBus_Stats_t _Stats[I2CBus_StatsCount];
+    static uint32_t _WindowStartMs;
+    static uint32_t _WindowBusyUs;
+    static uint16_t _DutyPermille;
+    static void Complete(I2CBus_Trans_t *const trans);
+    static uint8_t Execute(I2CBus_Trans_t *const trans);
+    static void Record(I2CBus_Trans_t const *const trans, uint32_t const busyUs);
+    static void RollWindow(uint32_t const nowMs);
+    static I2CBus_Stats_t* FindStats(uint8_t const addr);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern I2CBusClass I2CBus;
+
+#endif /* I2CBus_h */
+
+// I2CBus.h EOF
@@ -12,31 +12,61 @@
 // Header Files
 //-----------------------------------------------------------------------------
 #include <stdint.h>					// Standard Integer Header file
+#include "I2CBus.h"					// I2C Transaction Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define LightGrid_MaxPanels         8       // HT16K33 addresses 0x70 to 0x77
+#define LightGrid_BaseAddress       0x70
+#define LightGrid_NaturalOrder      0x76543210  // Panel n at address 0x70 + n
+#define LightGrid_CommandDepth      4       // Commands a panel can have waiting in the queue
 
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
+// Up to eight 12x8 grids chained along the 12 pixel side. Every pixel method
+// takes the panel it draws on, panel 0 is the first of the chain.
 class LightGrid {
     
     public:
     LightGrid() {} // Constructor
     static void Init();
+    static void SetPanels(uint8_t const count, uint32_t const order);
+    static uint8_t PanelCount() { return _PanelCount; }
     static bool Power(uint8_t const onOff);
     static bool Display(uint8_t const onOff);
     static bool Blink(uint8_t const blink);
     static bool Brightness(uint8_t const bright);
-    static void SetPixel(uint8_t const x, uint8_t const y, uint8_t const onOff);
-    static void SetColumn(uint8_t const column, uint16_t const val);
-    static void SetRow(uint8_t const row, uint8_t const val);
+    static void SetPixel(uint8_t const panel, uint8_t const x, uint8_t const y, uint8_t const onOff);
+    static void SetColumn(uint8_t const panel, uint8_t const column, uint16_t const val);
+    static void SetRow(uint8_t const panel, uint8_t const row, uint8_t const val);
     static bool WriteBuffer();
     static void ClearBuffer();
     static void InvertBuffer();
+    static uint16_t LitPixels();
+    static uint32_t FramesWritten;
+    static uint32_t FramesSkipped;
+    static uint32_t BytesSaved;
+    static uint32_t CommandErrors;
 
     private:
-    static uint8_t const _AddressI2C;
+    static uint8_t _PanelCount;
+    static uint8_t _Address[LightGrid_MaxPanels];
     static uint8_t const _RowLookup[12];
+    static uint16_t const _RowBit[12];
+    static uint16_t const _RowNibble[3][16];
     static uint8_t const _ColumnLookup[8];
-    static uint16_t _Buffer[8];
+    static uint16_t _Buffer[LightGrid_MaxPanels][8];
+    static uint8_t _WireBuffer[LightGrid_MaxPanels][16];
+    static uint8_t _ShadowBuffer[LightGrid_MaxPanels][16];
+    static uint8_t _ShadowValid;
+    static I2CBus_Trans_t _FrameTrans[LightGrid_MaxPanels];
+    static I2CBus_Trans_t _CommandTrans[LightGrid_MaxPanels][LightGrid_CommandDepth];
+    static uint8_t _CommandNext;
+    static bool WritePanel(uint8_t const panel);
+    static void FrameDone(I2CBus_Trans_t *const trans);
+    static void CommandDone(I2CBus_Trans_t *const trans);
     static bool WriteByte(uint8_t const byte);
 };
 
@@ -18,6 +18,32 @@
 // Public Macro Definitions
 //-----------------------------------------------------------------------------
 #define Mobility_MotorCount 2
+#define Mobility_ControlPeriodMs 20  // The control loop applies the setpoint at 50 Hz
+#define Mobility_InputMax 100        // Speed and steer setpoints are -100 to 100
+
+// Default ramps, in DRV8830 VSET steps per control tick. 0 is no limit.
+#define Mobility_AccelStep 2    // Speeding up, 0 to full in about 0.6 s
+#define Mobility_DecelStep 4    // Slowing down
+#define Mobility_ReverseStep 3  // Slowing down to change direction
+
+// Fault monitor, the FAULT registers are read every so many control ticks.
+#define Mobility_FaultPollDrive 10     // 200 ms while driving
+#define Mobility_FaultPollIdle 100     // 2 s otherwise
+#define Mobility_ILimitWindowMs 1000   // A second current limit this soon backs off VSET
+#define Mobility_LimitBackoff 8        // VSET steps taken off, and given back, at a time
+#define Mobility_LimitFloor 25         // The lowest the VSET limit backs off to
+#define Mobility_LimitRecoverMs 5000   // Quiet time before a step of VSET is given back
+#define Mobility_ThermalCoolMs 5000    // Rest after an over temperature shutdown
+#define Mobility_FaultSummarySize 80   // FaultSummary text for one motor
+
+// Deadman, manual driving stops when the input is older than the timeout.
+// The app is set to write the joystick every 100 ms, so a few of those missed
+// is a stalled link. Deadman_Vpin can change it, 0 turns it off.
+#define Mobility_DeadmanMs 500
+#define Mobility_LinkBuckets 8         // Input gap and age histograms, <25 ms up to 1.6 s and over
+#define Mobility_LinkBucketMs 25       // The first bucket, each one after is twice as wide
+#define Mobility_LinkWindow 256        // A histogram is halved when it holds this many
+#define Mobility_LinkSummarySize 80    // LinkSummary text
 
 //=============================================================================
 // Public Enumerated Constants
@@ -27,23 +53,148 @@ typedef enum {
     Mobility_FrontLeftMotor = 1
 } Mobility_MotorIndex;
 
+typedef enum {
+    Mobility_ManualOverride = 0,    // A setpoint or stop from the app
+    Mobility_ObstacleOverride = 1   // The obstacle reflex braked
+} Mobility_Override;
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+typedef void (*Mobility_ForwardFn)(bool const forward);
+typedef void (*Mobility_OverrideFn)(Mobility_Override const reason);
+
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
+// SetDrive only records the latest setpoint, from whichever input gave it.
+// The control loop applies it to the motors at a fixed rate, so the motors
+// see one update per tick however often the app sends. A setpoint replaced
+// before a tick used it is dropped, the latest one wins.
+// ScriptDrive is the same setpoint from a drive script. Anything from the app,
+// or the obstacle reflex braking, tells the override subscriber first so that
+// a running script gives way.
+// Manual setpoints are stamped as they arrive. The gap between them and the
+// age of the one being driven on go into rolling histograms, and the deadman
+// coasts or brakes once the age passes the timeout.
 class MobilityClass {
    private:
     DRV8830Class _Motors[Mobility_MotorCount];
+    int8_t _Speed;
+    int8_t _Steer;
+
+    // The speed each motor is driven at, ramped toward the mixed setpoint.
+    int8_t _Output[Mobility_MotorCount];
+    uint8_t _AccelStep;
+    uint8_t _DecelStep;
+    uint8_t _ReverseStep;
+    bool _Stopped;
+    bool _ScriptStop;
+    bool _Blocked;
+    bool _Forward;
+    Mobility_ForwardFn _ForwardFn;
+    Mobility_OverrideFn _OverrideFn;
+
+    // Fault monitor, per motor.
+    uint8_t _Limit[Mobility_MotorCount];
+    uint32_t _ILimitMs[Mobility_MotorCount];
+    uint32_t _RecoverMs[Mobility_MotorCount];
+    uint32_t _CoolMs[Mobility_MotorCount];
+    bool _Cooling[Mobility_MotorCount];
+    uint8_t _PollTicks;
+
+    // The setpoint, and when it arrived if a tick has not used it yet.
+    int8_t _SetSpeed;
+    int8_t _SetSteer;
+    bool _SetPending;
+    uint32_t _SetUs;
+
+    // Manual input, when it last arrived and how old it gets.
+    bool _Manual;
+    bool _InputMoving;
+    uint32_t _InputMs;
+    uint16_t _DeadmanMs;
+    bool _DeadmanBrake;
+    uint32_t _DeadmanTrips;
+    uint16_t _GapHist[Mobility_LinkBuckets];
+    uint16_t _AgeHist[Mobility_LinkBuckets];
+    uint32_t _AgeMaxMs;
+
+    // Control loop timing since the stats were last printed.
+    uint32_t _TickUs;
+    uint32_t _Ticks;
+    uint32_t _IntervalMinUs;
+    uint32_t _IntervalMaxUs;
+    uint32_t _LatencyMaxUs;
+    uint32_t _Setpoints;
+    uint32_t _Dropped;
+
+    bool ApplyDrive(int8_t const speed, int8_t const steer);
+    bool WriteMotors();
+    int8_t Ramp(int8_t const output, int8_t const target) const;
+    void PollFaults();
+    static void Mix(int8_t const speed, int8_t const steer, int8_t *const left,
+                    int8_t *const right);
+    void Setpoint(int8_t const speed, int8_t const steer);
+    void CheckInput();
+    static void CountLink(uint16_t *const hist, uint32_t const ms);
+    static uint16_t Percentile(uint16_t const *const hist, uint8_t const percent);
+    static uint8_t LinkBound(char *const buffer, uint8_t const size, uint8_t const length,
+                             uint16_t const ms);
+    void Brake();
+    void Release();
+    void Override(Mobility_Override const reason) {
+        if (_OverrideFn) _OverrideFn(reason);
+    }
+    void Control();
+    static void ControlTick();
 
    public:
     MobilityClass(DRV8830_Address const addrFL, DRV8830_Address const addrFR)
-        : _Motors{addrFL, addrFR} {}
+        : _Motors{addrFL, addrFR}, _Speed{0}, _Steer{0}, _Output{0, 0},
+          _AccelStep{Mobility_AccelStep}, _DecelStep{Mobility_DecelStep},
+          _ReverseStep{Mobility_ReverseStep}, _Stopped{false},
+          _ScriptStop{false}, _Blocked{false},
+          _Forward{false}, _ForwardFn{nullptr}, _OverrideFn{nullptr},
+          _Limit{DRV8830_MaxSpeed, DRV8830_MaxSpeed}, _ILimitMs{0, 0}, _RecoverMs{0, 0},
+          _CoolMs{0, 0}, _Cooling{false, false}, _PollTicks{0}, _SetSpeed{0},
+          _SetSteer{0}, _SetPending{false}, _SetUs{0}, _Manual{false}, _InputMoving{false},
+          _InputMs{0},
+          _DeadmanMs{Mobility_DeadmanMs}, _DeadmanBrake{false}, _DeadmanTrips{0},
+          _GapHist{}, _AgeHist{}, _AgeMaxMs{0}, _TickUs{0}, _Ticks{0},
+          _IntervalMinUs{UINT32_MAX}, _IntervalMaxUs{0}, _LatencyMaxUs{0},
+          _Setpoints{0}, _Dropped{0} {}
     MobilityClass() : MobilityClass{DRV8830_Addr0, DRV8830_Addr1} {}
     void SetMotorAddr(Mobility_MotorIndex const index,
                       DRV8830_Address const addr) {
         _Motors[index].SetAddress(addr);
     }
-    bool SetDrive(int8_t const speed, int8_t const steer);
+    void Begin();
+    void SetDrive(int8_t const speed, int8_t const steer);
+    void ScriptDrive(int8_t const speed, int8_t const steer);
+    void SetRamp(uint8_t const accel, uint8_t const decel, uint8_t const reverse);
+    void SetDeadman(uint16_t const timeoutMs, bool const brake) {
+        _DeadmanMs = timeoutMs;
+        _DeadmanBrake = brake;
+    }
+    uint16_t DeadmanMs() const { return _DeadmanMs; }
+    void EmergencyStop();
+    void ScriptBrake();
+    bool IsStopped() const { return _Stopped; }
+    bool SetObstacle(bool const ahead);
+    bool IsBlocked() const { return _Blocked; }
+    void SubscribeForward(Mobility_ForwardFn const fn) { _ForwardFn = fn; }
+    void SubscribeOverride(Mobility_OverrideFn const fn) { _OverrideFn = fn; }
+    bool IsDriving() const {
+        return _Speed != 0 || _Steer != 0 || _Output[0] != 0 || _Output[1] != 0;
+    }
     void PrintMotorFaults();
+    uint8_t FaultSummary(uint8_t const index, char *const buffer, uint8_t const size) const;
+    void PrintControlStats();
+    uint8_t LinkSummary(char *const buffer, uint8_t const size) const;
+    uint32_t WritesIssued() const;
+    uint32_t WritesSuppressed() const;
+    void PrintWriteStats();
 };
 
 //=============================================================================
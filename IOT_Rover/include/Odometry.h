@@ -0,0 +1,73 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Odometry.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Odometry.h
+// Description: Dead reckoning of the rover position from the wheel speeds.
+// Author:		Danon Bradford
+// Date:		2020-05-09
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Odometry.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Odometry_h
+#define Odometry_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+// Default wheel model, a VSET step count to a wheel speed.
+#define Odometry_FullSpeedMmS   340     // Wheel speed at full VSET
+#define Odometry_DeadSteps      4       // VSET steps that do not turn the wheel
+#define Odometry_TrackMm        90      // Distance between the wheels
+
+#define Odometry_MotionLimit    48      // Accelerometer counts that show the rover is moving
+#define Odometry_StallMs        1500    // Driving with no motion this long is a stalled rover
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Step is run by the motor control loop, with the VSET steps each wheel is
+// driven at. The wheel model is a table of micrometres per control tick, so a
+// step is a few table reads, multiplies and shifts.
+// x is forward from where the pose was reset and y is to the left, the
+// heading is a binary angle, 65536 is a full turn counter clockwise. It is
+// kept with 16 more bits, so that small turns every tick do not round away.
+// Once the accelerometer has reported, driving with no motion seen for
+// Odometry_StallMs is taken as stuck wheels and is not counted.
+class OdometryClass {
+    public:
+    OdometryClass() {} // Constructor
+    static void Reset();
+    static void SetModel(uint16_t const fullSpeedMmS, uint8_t const deadSteps, uint16_t const trackMm);
+    static void SetMotion(uint16_t const motion);
+    static void Step(int8_t const left, int8_t const right);
+    static int32_t X() { return _XUm / 1000; }
+    static int32_t Y() { return _YUm / 1000; }
+    static uint16_t Heading() { return _Heading >> 16; }
+    static uint16_t HeadingDegrees() { return ((_Heading >> 16) * 360 + 32768) >> 16; }
+    static void PrintStats();
+
+    private:
+    static uint16_t _TickUm[];
+    static int32_t _TurnScale;
+    static int32_t _XUm;
+    static int32_t _YUm;
+    static uint32_t _Heading;
+    static uint32_t _TravelUm;
+    static uint32_t _TravelMm;
+    static bool _AccelSeen;
+    static bool _Driving;
+    static uint32_t _MotionMs;
+    static uint32_t _StallTicks;
+    static int16_t Sine(uint16_t const angle);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern OdometryClass Odometry;
+
+#endif /* Odometry_h */
+
+// Odometry.h EOF
@@ -17,6 +17,11 @@
 #include "Display.h"
 #include "Distance.h"
 
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define Sensors_Summary     0xFF    // ShowOnDisplay ID, stream every sensor in turn
+
 //=============================================================================
 // Class Declaration
 //-----------------------------------------------------------------------------
@@ -27,6 +32,7 @@ class SensorsClass
     static uint8_t ShowOnDisplayPrimary;
     static void Init(EC_12S_t *const errorCodePtr);
     static void ShowOnDisplay(uint8_t const show, uint8_t const vpin);
+    static uint8_t SummarySource(char *const buffer, uint8_t const size);
 
     // DHT11 Sensor
     static uint16_t RawTemperature;
@@ -52,6 +58,7 @@ class SensorsClass
     // Distance sensor
     static uint16_t RawDistance;
     static uint16_t GetDistance();
+    static void SetTofBrake(uint16_t const distanceMm);
 
     // Accelerometer
     static int AccTID;
@@ -71,6 +78,14 @@ class SensorsClass
     static Distance _TofSensor;
     static int _TofTID;
     static void TofRun();
+    static uint16_t _TofBrakeMm;
+    static bool _TofForward;
+    static void TofForward(bool const forward);
+    static int _RatesTID;
+    static bool _RatesActive;
+    static uint32_t _RatesActiveMs;
+    static void RatesRun();
+    static void ApplyRates();
 };
 
 //=============================================================================
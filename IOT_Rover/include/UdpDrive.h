@@ -0,0 +1,103 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH UdpDrive.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	UdpDrive.h
+// Description: Drive the rover over UDP on the local network, not the cloud.
+// Author:		Danon Bradford
+// Date:		2020-05-23
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH UdpDrive.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef UdpDrive_h
+#define UdpDrive_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define UdpDrive_Port           4210
+#define UdpDrive_Magic0         'I'     // Every packet starts "IR"
+#define UdpDrive_Magic1         'R'
+#define UdpDrive_CommandSize    9       // Magic, type, token and sequence number
+#define UdpDrive_MaxText        32      // Characters in a text packet
+#define UdpDrive_MaxPacket      (UdpDrive_CommandSize + 1 + UdpDrive_MaxText)
+#define UdpDrive_TextMs         3000    // How long a text packet is shown
+#define UdpDrive_PacketsPerRun  4       // Packets handled each loop() pass
+
+//=============================================================================
+// Public Enumerated Constants
+//-----------------------------------------------------------------------------
+// The byte after the magic. Numbers are sent high byte first.
+typedef enum {
+    UdpDrive_Hello = 0x01,      // Client nonce (4), starts a session
+    UdpDrive_Drive = 0x02,      // Token (4), sequence (2), speed, steer
+    UdpDrive_Text = 0x03,       // Token (4), sequence (2), length, characters
+    UdpDrive_Stop = 0x04,       // Token (4), sequence (2), emergency stop
+    UdpDrive_Welcome = 0x81,    // Rover nonce (4), the reply to Hello
+    UdpDrive_Ack = 0x82         // Sequence (2), the reply to a command that was used
+} UdpDrive_Type;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Listens while the station is connected and the Blynk token is valid.
+// A client sends Hello with a nonce and the rover answers with its own. Both
+// sides then work out the session token from the Blynk auth token and the two
+// nonces, so the auth token itself is never sent. Every command carries the
+// token and a sequence number. A new session takes over once its first good
+// command arrives, so a stray Hello does not cut off the driver. A command
+// older than the last one used is dropped, so a late packet can not undo a
+// newer setpoint.
+// The token keeps out anyone without the auth token, it is not encryption.
+// Drive goes to the same Mobility setpoint as the Blynk joystick.
+class UdpDriveClass {
+    public:
+    UdpDriveClass() {} // Constructor
+    static void Begin();
+    static void Run();
+    static void PrintStats();
+
+    // FNV-1a of the auth token then the nonces. Also used by tools/UdpClient.cpp.
+    static uint32_t Token(const char *auth, uint32_t const roverNonce, uint32_t const clientNonce) {
+        uint32_t hash = 2166136261u;
+
+        while (*auth)
+            hash = (hash ^ (uint8_t)*auth++) * 16777619u;
+
+        for (uint8_t shift = 0; shift < 32; shift += 8) {
+            hash = (hash ^ (uint8_t)(roverNonce >> shift)) * 16777619u;
+            hash = (hash ^ (uint8_t)(clientNonce >> shift)) * 16777619u;
+        }
+
+        return hash;
+    }
+
+    private:
+    static bool _Listening;
+    static bool _Session;
+    static uint32_t _Token;
+    static bool _Pending;
+    static uint32_t _PendingToken;
+    static bool _SeqValid;
+    static uint16_t _Seq;
+    static uint32_t _Packets;
+    static uint32_t _Used;
+    static uint32_t _Reordered;
+    static uint32_t _Rejected;
+    static uint32_t _Sessions;
+    static void Status(const bool connected);
+    static void Handle(uint8_t const *const packet, uint8_t const length);
+    static bool Command(uint8_t const *const packet, uint8_t const length);
+    static bool FromSession(uint32_t const token);
+    static void Reply(uint8_t const type, uint32_t const value, uint8_t const bytes);
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern UdpDriveClass UdpDrive;
+
+#endif /* UdpDrive_h */
+
+// UdpDrive.h EOF
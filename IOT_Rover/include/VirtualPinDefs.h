@@ -20,7 +20,8 @@
 #define TempShowNow_Vpin        V13 
 #define Distance_Vpin           V14
 #define JoystickInput_Vpin      V15 
-// V16 - V17 Spare
+#define I2CReport_Vpin          V16
+#define Animation_Vpin          V17
 #define SwitchA_Vpin            V18
 #define SwitchB_Vpin            V19
 #define PushPeriod_Vpin         V20
@@ -40,13 +41,25 @@
 #define LocalIP_Vpin            V34
 #define TempOffset_Vpin         V35
 #define HumOffset_Vpin          V36
-// V37 - V39 Spare
+#define AutoBrightness_Vpin     V37
+#define DisplayIdle_Vpin        V38
+// V39 Spare
 #define MobilityStatus_Vpin     V40
 #define MobilityJoy_Vpin        V41
 #define MobilitySpeed_Vpin      V42
 #define MobilitySteer_Vpin      V43
 #define MobilityFLAddr_Vpin     V44
 #define MobilityFRAddr_Vpin     V45
+#define MobilityStop_Vpin       V46
+#define MobilityRamp_Vpin       V47
+#define TofBrake_Vpin           V48
+#define OdometryPose_Vpin       V49
+#define OdometryReset_Vpin      V50
+#define OdometryModel_Vpin      V51
+#define MotorFaults_Vpin        V52
+#define DriveScript_Vpin        V53
+#define Deadman_Vpin            V54
+#define DriveLink_Vpin          V55
 
 #endif /* VirtualPinDefs_h */
 
@@ -25,6 +25,7 @@ public:
   bool XYZHasChanged;
   uint32_t StepCount; //  keeps track of the number of steps
   uint8_t Rotation;
+  uint16_t Motion;    // sum of the absolute x/y/z change since the last read
 
   TPedometer(); // Constructor
   uint8_t Init();
@@ -0,0 +1,42 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Adafruit_VL53L0X.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Adafruit_VL53L0X.h
+// Description: Host stand-in for the VL53L0X library, the distance is Host's.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Adafruit_VL53L0X.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Adafruit_VL53L0X_h
+#define Adafruit_VL53L0X_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Only the calls Distance makes. Each ranging takes Host_TofRangingUs and
+// reports Host.TofMm as it was when the ranging began.
+class Adafruit_VL53L0X {
+    public:
+    typedef enum {
+        VL53L0X_SENSE_DEFAULT = 0,
+        VL53L0X_SENSE_LONG_RANGE,
+        VL53L0X_SENSE_HIGH_SPEED,
+        VL53L0X_SENSE_HIGH_ACCURACY
+    } VL53L0X_Sense_config_t;
+
+    boolean begin(uint8_t const i2c_addr = 0x29, boolean const debug = false,
+                  VL53L0X_Sense_config_t const vl_config = VL53L0X_SENSE_DEFAULT);
+    boolean configSensor(VL53L0X_Sense_config_t const vl_config);
+    boolean startRange();
+    boolean startRangeContinuous(uint16_t const period_ms = 50);
+    void stopRangeContinuous();
+    boolean isRangeComplete();
+    uint16_t readRangeResult();
+};
+
+#endif /* Adafruit_VL53L0X_h */
+
+// Adafruit_VL53L0X.h EOF
@@ -0,0 +1,95 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Arduino.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Arduino.h
+// Description: Host stand-in for the parts of the ESP8266 Arduino core in use.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Arduino.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Arduino_h
+#define Arduino_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdint.h>					// Standard Integer Header file
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define HIGH                0x1
+#define LOW                 0x0
+#define INPUT               0x00
+#define OUTPUT              0x01
+#define DEC                 10
+#define HEX                 16
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define memcpy_P                memcpy
+
+#ifndef PI
+#define PI                  3.1415926535897932384626433832795
+#endif
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define RANDOM_REG32        ((uint32_t)rand())
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Declared only, so that firmware built for the host can not use it.
+class String {
+    public:
+    const char *c_str() const;
+};
+
+// Serial output is dropped unless Host.Echo is set.
+class Print {
+    public:
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *text);
+    size_t print(char c);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(double value, int digits = 2);
+    size_t println() { return print("\n"); }
+    template <typename T> size_t println(T value) { return print(value) + println(); }
+    template <typename T> size_t println(T value, int format) { return print(value, format) + println(); }
+};
+
+class HardwareSerial : public Print {
+    public:
+    void begin(unsigned long const baud) { (void)baud; }
+};
+
+class EspClass {
+    public:
+    uint32_t getCycleCount();
+    uint32_t getFreeHeap();
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern HardwareSerial Serial;
+extern EspClass ESP;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long const ms);
+void yield();
+
+#endif /* Arduino_h */
+
+// Arduino.h EOF
@@ -0,0 +1,59 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH BlynkTimer.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	BlynkTimer.h
+// Description: Host stand-in for BlynkTimer, run from the Host clock.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH BlynkTimer.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef BlynkTimer_h
+#define BlynkTimer_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define BlynkTimer_MaxTimers    16      // As the Blynk library
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// The same rules as the Blynk SimpleTimer. A timer is due once its delay has
+// passed since it was last due, a late run does not push back the next one.
+// changeInterval and restartTimer start the delay again from now.
+class BlynkTimer {
+    public:
+    typedef void (*timer_callback)(void);
+    BlynkTimer();
+    int setInterval(unsigned long const ms, timer_callback const fn) { return Add(ms, fn, 0); }
+    int setTimeout(unsigned long const ms, timer_callback const fn) { return Add(ms, fn, 1); }
+    int setTimer(unsigned long const ms, timer_callback const fn, unsigned const runs) { return Add(ms, fn, runs); }
+    bool changeInterval(unsigned const id, unsigned long const ms);
+    void deleteTimer(unsigned const id);
+    void restartTimer(unsigned const id);
+    bool isEnabled(unsigned const id);
+    void enable(unsigned const id);
+    void disable(unsigned const id);
+    unsigned getNumTimers();
+    void run();
+
+    private:
+    typedef struct {
+        bool Used;
+        bool Enabled;
+        unsigned long DelayMs;
+        unsigned long PrevMs;
+        timer_callback Fn;
+        unsigned Runs;
+        unsigned MaxRuns;       // 0 runs for ever
+    } Timer_t;
+    Timer_t _Timers[BlynkTimer_MaxTimers];
+    int Add(unsigned long const ms, timer_callback const fn, unsigned const runs);
+};
+
+#endif /* BlynkTimer_h */
+
+// BlynkTimer.h EOF
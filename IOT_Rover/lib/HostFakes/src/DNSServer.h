@@ -0,0 +1,17 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH DNSServer.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	DNSServer.h
+// Description: Host stand-in, WiFiMgmt.h names the type.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH DNSServer.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef DNSServer_h
+#define DNSServer_h
+
+#include <ESP8266WiFi.h>
+
+class DNSServer {};
+
+#endif /* DNSServer_h */
+
+// DNSServer.h EOF
@@ -0,0 +1,17 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WebServer.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	ESP8266WebServer.h
+// Description: Host stand-in, WiFiMgmt.h names the type.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WebServer.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef ESP8266WebServer_h
+#define ESP8266WebServer_h
+
+#include <ESP8266WiFi.h>
+
+class ESP8266WebServer {};
+
+#endif /* ESP8266WebServer_h */
+
+// ESP8266WebServer.h EOF
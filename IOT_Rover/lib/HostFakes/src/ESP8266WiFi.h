@@ -0,0 +1,35 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WiFi.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	ESP8266WiFi.h
+// Description: Host stand-in for the ESP8266 WiFi types in use.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WiFi.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef ESP8266WiFi_h
+#define ESP8266WiFi_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Byte 0 is the first number of the dotted address, as on the ESP8266.
+class IPAddress {
+    public:
+    IPAddress() : _Address(0) {}
+    IPAddress(uint32_t const address) : _Address(address) {}
+    IPAddress(uint8_t const a, uint8_t const b, uint8_t const c, uint8_t const d)
+        : _Address((uint32_t)a | (uint32_t)b << 8 | (uint32_t)c << 16 | (uint32_t)d << 24) {}
+    operator uint32_t() const { return _Address; }
+    uint8_t operator[](int const index) const { return _Address >> (8 * index); }
+
+    private:
+    uint32_t _Address;
+};
+
+#endif /* ESP8266WiFi_h */
+
+// ESP8266WiFi.h EOF
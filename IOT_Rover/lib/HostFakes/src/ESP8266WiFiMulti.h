@@ -0,0 +1,17 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WiFiMulti.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	ESP8266WiFiMulti.h
+// Description: Host stand-in, WiFiMgmt.h names the type.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH ESP8266WiFiMulti.h HHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef ESP8266WiFiMulti_h
+#define ESP8266WiFiMulti_h
+
+#include <ESP8266WiFi.h>
+
+class ESP8266WiFiMulti {};
+
+#endif /* ESP8266WiFiMulti_h */
+
+// ESP8266WiFiMulti.h EOF
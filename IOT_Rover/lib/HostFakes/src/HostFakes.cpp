@@ -0,0 +1,529 @@
+//////////////////////////////// HostFakes.cpp ////////////////////////////////
+// Filename:	HostFakes.cpp
+// Description: The clock, I2C devices and UDP peers behind the host stand-ins.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// HostFakes.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdarg.h>
+#include <stdio.h>
+#include <Arduino.h>				// Arduino Header file
+#include <Wire.h>					// I2C Header file
+#include <WiFiUdp.h>
+#include <Adafruit_VL53L0X.h>
+#include <Blynk/BlynkTimer.h>
+#include "DeviceConfig.h"			// DeviceConfig Header file
+#include "WiFiMgmt.h"				// WiFiMgmt Header file
+#include "HostFakes.h"				// Source Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define StatusSubscribers   4
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+HostClass Host;
+HardwareSerial Serial;
+EspClass ESP;
+TwoWire Wire;
+
+// Defined by IDL_Firmware.cpp, DeviceConfig.cpp and WiFiMgmt.cpp on the rover.
+BlynkTimer GlobalTimer;
+DeviceConfigClass DeviceConfig;
+WiFiMgmtClass WiFiMgmt;
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// Each device's register pointer.
+static uint8_t Pointer[128];
+
+// The transaction being built by Wire, and the bytes of the last read.
+static Host_I2C_t WireTx;
+static uint8_t WireRx[Host_I2CMaxBytes];
+static uint8_t WireRxLength = 0;
+static uint8_t WireRxIndex = 0;
+
+// The packet being read, and the reply being built.
+static Host_Udp_t UdpPacket;
+static Host_Udp_t UdpReply;
+
+// The VL53L0X ranging under way, and the result waiting to be read.
+static uint32_t TofStartUs = 0;
+static uint16_t TofSeenMm = 0;
+static uint16_t TofResult = 0;
+static bool TofReady = false;
+
+static char BlynkToken[] = "HostBlynkAuthToken";
+static WiFiMgmt_SubscriptionFn StatusFns[StatusSubscribers];
+static uint8_t StatusCount = 0;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+// The clock starts a second after boot, so that no time reads as unset.
+uint32_t HostClass::Us = 1000000;
+bool HostClass::Echo = false;
+void (*HostClass::_Loop)() = NULL;
+
+uint8_t HostClass::Registers[128][256];
+bool HostClass::Nack[128];
+Host_WriteFn HostClass::WriteHook = NULL;
+Host_I2C_t HostClass::I2CLog[Host_I2CLogSize];
+uint16_t HostClass::I2CCount = 0;
+
+uint16_t HostClass::UdpListening = 0;
+Host_Udp_t HostClass::UdpIn[Host_UdpQueueSize];
+uint8_t HostClass::UdpInCount = 0;
+Host_Udp_t HostClass::UdpOut[Host_UdpQueueSize];
+uint8_t HostClass::UdpOutCount = 0;
+
+uint16_t HostClass::TofMm = 0xFFFF;
+bool HostClass::TofContinuous = false;
+bool HostClass::TofRanging = false;
+uint32_t HostClass::TofRangings = 0;
+uint32_t HostClass::TofResultUs = 0;
+
+char* DeviceConfigClass::BlynkTokenNv = BlynkToken;
+bool DeviceConfigClass::ValidBlynk = true;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static void LogI2C(Host_I2C_t const *const trans) {
+    if (HostClass::I2CCount < Host_I2CLogSize)
+        HostClass::I2CLog[HostClass::I2CCount++] = *trans;
+}
+
+//=============================================================================
+// Host Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// Forget the devices, the logs and the packets. The clock and timers carry on.
+void HostClass::Reset() {
+    memset(Registers, 0, sizeof(Registers));
+    memset(Nack, 0, sizeof(Nack));
+    memset(Pointer, 0, sizeof(Pointer));
+    WriteHook = NULL;
+    I2CCount = 0;
+    UdpInCount = 0;
+    UdpOutCount = 0;
+    TofMm = 0xFFFF;
+    TofContinuous = false;
+    TofRanging = false;
+    TofRangings = 0;
+    TofReady = false;
+    _Loop = NULL;
+}
+
+// Move the clock on a ms at a time, running the VL53L0X, the timers and then
+// the loop.
+void HostClass::Run(uint32_t const ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        Us += 1000;
+        TofTick();
+        GlobalTimer.run();
+        if (_Loop) _Loop();
+    }
+}
+
+void HostClass::SetLoop(void (*loop)()) {
+    _Loop = loop;
+}
+
+// Finish the ranging under way once it has taken its time. Back to back, the
+// next one starts straight away.
+void HostClass::TofTick() {
+    if (!TofRanging || Us - TofStartUs < Host_TofRangingUs)
+        return;
+
+    TofResult = TofSeenMm;
+    TofResultUs = TofStartUs;
+    TofReady = true;
+    TofRangings++;
+
+    TofRanging = TofContinuous;
+    TofStartUs = Us;
+    TofSeenMm = TofMm;
+}
+
+bool HostClass::UdpSend(IPAddress const ip, uint16_t const port, uint8_t const *const data, uint8_t const length) {
+    if (UdpListening == 0 || UdpInCount >= Host_UdpQueueSize || length > Host_UdpMaxBytes)
+        return false;
+
+    Host_Udp_t *const packet = &UdpIn[UdpInCount++];
+    packet->Ip = ip;
+    packet->Port = port;
+    packet->Length = length;
+    memcpy(packet->Data, data, length);
+    return true;
+}
+
+// The oldest reply from the firmware, false if there is none.
+bool HostClass::UdpReceive(Host_Udp_t *const packet) {
+    if (UdpOutCount == 0)
+        return false;
+
+    *packet = UdpOut[0];
+    memmove(&UdpOut[0], &UdpOut[1], --UdpOutCount * sizeof(UdpOut[0]));
+    return true;
+}
+
+void HostClass::WiFiStatus(bool const connected) {
+    for (uint8_t i = 0; i < StatusCount; i++)
+        StatusFns[i](connected);
+}
+
+bool WiFiMgmtClass::SubscribeStatus(WiFiMgmt_SubscriptionFn userFunction) {
+    if (StatusCount >= StatusSubscribers)
+        return false;
+
+    StatusFns[StatusCount++] = userFunction;
+    return true;
+}
+
+//=============================================================================
+// Adafruit_VL53L0X
+//-----------------------------------------------------------------------------
+boolean Adafruit_VL53L0X::begin(uint8_t const i2c_addr, boolean const debug,
+                                VL53L0X_Sense_config_t const vl_config) {
+    (void)i2c_addr; (void)debug; (void)vl_config;
+    return true;
+}
+
+boolean Adafruit_VL53L0X::configSensor(VL53L0X_Sense_config_t const vl_config) {
+    (void)vl_config;
+    return true;
+}
+
+boolean Adafruit_VL53L0X::startRange() {
+    HostClass::TofRanging = true;
+    TofStartUs = HostClass::Us;
+    TofSeenMm = HostClass::TofMm;
+    TofReady = false;
+    return true;
+}
+
+boolean Adafruit_VL53L0X::startRangeContinuous(uint16_t const period_ms) {
+    (void)period_ms;
+    HostClass::TofContinuous = true;
+    return startRange();
+}
+
+void Adafruit_VL53L0X::stopRangeContinuous() {
+    HostClass::TofContinuous = false;
+    HostClass::TofRanging = false;
+    TofReady = false;
+}
+
+boolean Adafruit_VL53L0X::isRangeComplete() {
+    return TofReady;
+}
+
+uint16_t Adafruit_VL53L0X::readRangeResult() {
+    TofReady = false;
+    return TofResult;
+}
+
+//=============================================================================
+// Arduino Core
+//-----------------------------------------------------------------------------
+unsigned long millis() {
+    return HostClass::Us / 1000;
+}
+
+unsigned long micros() {
+    return HostClass::Us;
+}
+
+// Time passes, but nothing else runs.
+void delay(unsigned long const ms) {
+    HostClass::Us += ms * 1000;
+}
+
+void yield() {
+}
+
+size_t Print::printf(const char *format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int const length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (HostClass::Echo)
+        fputs(text, stdout);
+
+    return length < 0 ? 0 : length;
+}
+
+size_t Print::print(const char *text) {
+    return printf("%s", text);
+}
+
+size_t Print::print(char const c) {
+    return printf("%c", c);
+}
+
+size_t Print::print(long const value, int const base) {
+    return base == HEX ? printf("%lX", value) : printf("%ld", value);
+}
+
+size_t Print::print(unsigned long const value, int const base) {
+    return base == HEX ? printf("%lX", value) : printf("%lu", value);
+}
+
+size_t Print::print(double const value, int const digits) {
+    return printf("%.*f", digits, value);
+}
+
+// A few cycles a call, so that cycle counts are not zero.
+uint32_t EspClass::getCycleCount() {
+    static uint32_t cycles = 0;
+    return cycles += 80;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return 40000;
+}
+
+//=============================================================================
+// Wire
+//-----------------------------------------------------------------------------
+void TwoWire::beginTransmission(uint8_t const addr) {
+    memset(&WireTx, 0, sizeof(WireTx));
+    WireTx.Addr = addr & 0x7F;
+}
+
+size_t TwoWire::write(uint8_t const data) {
+    if (WireTx.Length >= Host_I2CMaxBytes)
+        return 0;
+
+    WireTx.Data[WireTx.Length++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t const length) {
+    size_t written = 0;
+
+    while (written < length && write(data[written]))
+        written++;
+
+    return written;
+}
+
+// 0 when acknowledged, 2 for an address that does not answer.
+uint8_t TwoWire::endTransmission(uint8_t const sendStop) {
+    (void)sendStop;
+    uint8_t const addr = WireTx.Addr;
+    WireTx.Acked = !HostClass::Nack[addr];
+    LogI2C(&WireTx);
+
+    if (!WireTx.Acked)
+        return 2;
+
+    if (WireTx.Length > 0) {
+        Pointer[addr] = WireTx.Data[0];
+
+        for (uint8_t i = 1; i < WireTx.Length; i++)
+            HostClass::Registers[addr][Pointer[addr]++] = WireTx.Data[i];
+
+        // A write of only the register leaves the pointer on it, for a read.
+        if (WireTx.Length > 1)
+            Pointer[addr] = WireTx.Data[0];
+    }
+
+    if (HostClass::WriteHook)
+        HostClass::WriteHook(addr, WireTx.Data, WireTx.Length);
+
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t const addr, uint8_t const length) {
+    Host_I2C_t read;
+    memset(&read, 0, sizeof(read));
+    read.Addr = addr & 0x7F;
+    read.Read = true;
+    read.Acked = !HostClass::Nack[read.Addr];
+
+    WireRxLength = 0;
+    WireRxIndex = 0;
+
+    if (read.Acked) {
+        while (WireRxLength < length && WireRxLength < Host_I2CMaxBytes)
+            WireRx[WireRxLength++] = HostClass::Registers[read.Addr][Pointer[read.Addr]++];
+
+        read.Length = WireRxLength;
+        memcpy(read.Data, WireRx, WireRxLength);
+    }
+
+    LogI2C(&read);
+    return WireRxLength;
+}
+
+int TwoWire::available() {
+    return WireRxLength - WireRxIndex;
+}
+
+int TwoWire::read() {
+    return WireRxIndex < WireRxLength ? WireRx[WireRxIndex++] : -1;
+}
+
+//=============================================================================
+// WiFiUDP
+//-----------------------------------------------------------------------------
+uint8_t WiFiUDP::begin(uint16_t const port) {
+    HostClass::UdpListening = port;
+    return 1;
+}
+
+void WiFiUDP::stop() {
+    HostClass::UdpListening = 0;
+    HostClass::UdpInCount = 0;
+}
+
+int WiFiUDP::parsePacket() {
+    if (HostClass::UdpInCount == 0)
+        return 0;
+
+    UdpPacket = HostClass::UdpIn[0];
+    memmove(&HostClass::UdpIn[0], &HostClass::UdpIn[1], --HostClass::UdpInCount * sizeof(HostClass::UdpIn[0]));
+    return UdpPacket.Length;
+}
+
+int WiFiUDP::read(uint8_t *buffer, size_t const length) {
+    size_t const count = length < UdpPacket.Length ? length : UdpPacket.Length;
+    memcpy(buffer, UdpPacket.Data, count);
+    return count;
+}
+
+IPAddress WiFiUDP::remoteIP() {
+    return IPAddress(UdpPacket.Ip);
+}
+
+uint16_t WiFiUDP::remotePort() {
+    return UdpPacket.Port;
+}
+
+int WiFiUDP::beginPacket(IPAddress const ip, uint16_t const port) {
+    memset(&UdpReply, 0, sizeof(UdpReply));
+    UdpReply.Ip = ip;
+    UdpReply.Port = port;
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t *buffer, size_t const length) {
+    size_t const count = length < (size_t)(Host_UdpMaxBytes - UdpReply.Length) ? length : Host_UdpMaxBytes - UdpReply.Length;
+    memcpy(&UdpReply.Data[UdpReply.Length], buffer, count);
+    UdpReply.Length += count;
+    return count;
+}
+
+int WiFiUDP::endPacket() {
+    if (HostClass::UdpOutCount >= Host_UdpQueueSize)
+        return 0;
+
+    HostClass::UdpOut[HostClass::UdpOutCount++] = UdpReply;
+    return 1;
+}
+
+//=============================================================================
+// BlynkTimer
+//-----------------------------------------------------------------------------
+BlynkTimer::BlynkTimer() {
+    memset(_Timers, 0, sizeof(_Timers));
+}
+
+int BlynkTimer::Add(unsigned long const ms, timer_callback const fn, unsigned const runs) {
+    for (int id = 0; id < BlynkTimer_MaxTimers; id++) {
+        Timer_t *const timer = &_Timers[id];
+
+        if (!timer->Used) {
+            timer->Used = true;
+            timer->Enabled = true;
+            timer->DelayMs = ms;
+            timer->PrevMs = millis();
+            timer->Fn = fn;
+            timer->Runs = 0;
+            timer->MaxRuns = runs;
+            return id;
+        }
+    }
+
+    return -1;
+}
+
+bool BlynkTimer::changeInterval(unsigned const id, unsigned long const ms) {
+    if (id >= BlynkTimer_MaxTimers || !_Timers[id].Used)
+        return false;
+
+    _Timers[id].DelayMs = ms;
+    _Timers[id].PrevMs = millis();
+    return true;
+}
+
+void BlynkTimer::deleteTimer(unsigned const id) {
+    if (id < BlynkTimer_MaxTimers)
+        _Timers[id].Used = false;
+}
+
+void BlynkTimer::restartTimer(unsigned const id) {
+    if (id < BlynkTimer_MaxTimers)
+        _Timers[id].PrevMs = millis();
+}
+
+bool BlynkTimer::isEnabled(unsigned const id) {
+    return id < BlynkTimer_MaxTimers && _Timers[id].Used && _Timers[id].Enabled;
+}
+
+void BlynkTimer::enable(unsigned const id) {
+    if (id < BlynkTimer_MaxTimers)
+        _Timers[id].Enabled = true;
+}
+
+void BlynkTimer::disable(unsigned const id) {
+    if (id < BlynkTimer_MaxTimers)
+        _Timers[id].Enabled = false;
+}
+
+unsigned BlynkTimer::getNumTimers() {
+    unsigned count = 0;
+
+    for (int id = 0; id < BlynkTimer_MaxTimers; id++)
+        count += _Timers[id].Used;
+
+    return count;
+}
+
+void BlynkTimer::run() {
+    unsigned long const nowMs = millis();
+
+    for (int id = 0; id < BlynkTimer_MaxTimers; id++) {
+        Timer_t *const timer = &_Timers[id];
+
+        if (!timer->Used || nowMs - timer->PrevMs < timer->DelayMs)
+            continue;
+
+        // Skip the runs that were missed, as the library does.
+        if (timer->DelayMs == 0)
+            timer->PrevMs = nowMs;
+        else
+            timer->PrevMs += (nowMs - timer->PrevMs) / timer->DelayMs * timer->DelayMs;
+
+        if (!timer->Enabled)
+            continue;
+
+        // The callback may set a new timer in this slot.
+        timer_callback const fn = timer->Fn;
+        if (timer->MaxRuns && ++timer->Runs >= timer->MaxRuns)
+            timer->Used = false;
+
+        fn();
+    }
+}
+
+// HostFakes.cpp EOF
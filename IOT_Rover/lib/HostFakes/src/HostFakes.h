@@ -0,0 +1,106 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH HostFakes.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	HostFakes.h
+// Description: The clock, I2C devices and UDP peers behind the host stand-ins.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH HostFakes.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef HostFakes_h
+#define HostFakes_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include <Blynk/BlynkTimer.h>
+#include <ESP8266WiFi.h>
+
+//=============================================================================
+// Public Macro Definitions
+//-----------------------------------------------------------------------------
+#define Host_I2CLogSize         1024    // Transactions kept, later ones are dropped
+#define Host_I2CMaxBytes        24      // Bytes kept of each transaction
+#define Host_UdpQueueSize       16      // Packets waiting each way
+#define Host_UdpMaxBytes        64
+#define Host_TofRangingUs       20000   // One VL53L0X ranging in the high speed mode
+
+//=============================================================================
+// Public Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+typedef struct {
+    uint8_t Addr;
+    bool Read;                  // A requestFrom, otherwise a write
+    bool Acked;
+    uint8_t Length;
+    uint8_t Data[Host_I2CMaxBytes];
+} Host_I2C_t;
+
+typedef struct {
+    uint32_t Ip;
+    uint16_t Port;
+    uint8_t Length;
+    uint8_t Data[Host_UdpMaxBytes];
+} Host_Udp_t;
+
+// Called after an acknowledged write has been stored, so that a device model
+// can act on it, for example clear a fault register.
+typedef void (*Host_WriteFn)(uint8_t const addr, uint8_t const *const data, uint8_t const length);
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+// Each I2C address is a bank of 256 registers. A write sets the register
+// pointer from its first byte and stores the rest from there on, a read
+// returns bytes from the pointer on. An address in Nack does not answer.
+// The clock only moves when a test runs it, the VL53L0X and then GlobalTimer
+// run each ms.
+class HostClass {
+    public:
+    HostClass() {} // Constructor
+    static void Reset();
+    static void Run(uint32_t const ms);
+    static void SetLoop(void (*loop)());
+    static uint32_t Us;
+    static bool Echo;
+
+    // I2C
+    static uint8_t Registers[128][256];
+    static bool Nack[128];
+    static Host_WriteFn WriteHook;
+    static Host_I2C_t I2CLog[Host_I2CLogSize];
+    static uint16_t I2CCount;
+    static void ClearI2CLog() { I2CCount = 0; }
+
+    // UDP, to the port the firmware listens on and back.
+    static uint16_t UdpListening;
+    static Host_Udp_t UdpIn[Host_UdpQueueSize];
+    static uint8_t UdpInCount;
+    static Host_Udp_t UdpOut[Host_UdpQueueSize];
+    static uint8_t UdpOutCount;
+    static bool UdpSend(IPAddress const ip, uint16_t const port, uint8_t const *const data, uint8_t const length);
+    static bool UdpReceive(Host_Udp_t *const packet);
+
+    // WiFiMgmt is not built on the host, this is its station status.
+    static void WiFiStatus(bool const connected);
+
+    // The VL53L0X, what is ahead of it and what it is doing.
+    static uint16_t TofMm;              // 0xFFFF for nothing in range
+    static bool TofContinuous;          // Ranging back to back
+    static bool TofRanging;
+    static uint32_t TofRangings;        // Rangings finished
+    static uint32_t TofResultUs;        // When the ranging of the last result began
+
+    private:
+    static void (*_Loop)();
+    static void TofTick();
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern HostClass Host;
+extern BlynkTimer GlobalTimer;
+
+#endif /* HostFakes_h */
+
+// HostFakes.h EOF
@@ -0,0 +1,34 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH WiFiUdp.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	WiFiUdp.h
+// Description: Host stand-in for WiFiUDP, packets go through the Host queues.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH WiFiUdp.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <ESP8266WiFi.h>
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+class WiFiUDP {
+    public:
+    uint8_t begin(uint16_t const port);
+    void stop();
+    int parsePacket();
+    int read(uint8_t *buffer, size_t const length);
+    IPAddress remoteIP();
+    uint16_t remotePort();
+    int beginPacket(IPAddress const ip, uint16_t const port);
+    size_t write(const uint8_t *buffer, size_t const length);
+    int endPacket();
+};
+
+#endif /* WiFiUdp_h */
+
+// WiFiUdp.h EOF
@@ -0,0 +1,39 @@
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Wire.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Filename:	Wire.h
+// Description: Host stand-in for the I2C bus, the devices are Host registers.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH Wire.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+#ifndef Wire_h
+#define Wire_h
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+
+//=============================================================================
+// Class Declaration
+//-----------------------------------------------------------------------------
+class TwoWire {
+    public:
+    void begin() {}
+    void setClock(uint32_t const hz) { (void)hz; }
+    void beginTransmission(uint8_t const addr);
+    size_t write(uint8_t const data);
+    size_t write(const uint8_t *data, size_t const length);
+    uint8_t endTransmission(uint8_t const sendStop = true);
+    uint8_t requestFrom(uint8_t const addr, uint8_t const length);
+    int available();
+    int read();
+};
+
+//=============================================================================
+// Global Instance Declarations (Publicly Accessible)
+//-----------------------------------------------------------------------------
+extern TwoWire Wire;
+
+#endif /* Wire_h */
+
+// Wire.h EOF
@@ -0,0 +1,196 @@
+//////////////////////////////// Animation.cpp ////////////////////////////////
+// Filename:	Animation.cpp
+// Description: Play a list of frames on the IDL display.
+// Author:		Danon Bradford
+// Date:		2020-03-28
+//////////////////////////////// Animation.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include <Blynk/BlynkTimer.h>
+#include "Display.h"				// Display Header file
+#include "Format.h"					// Format Header file
+#include "Animation.h"				// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+AnimationClass Animation;
+
+//*****************************************************************************
+// Externally Defined Global Variables
+//-----------------------------------------------------------------------------
+extern BlynkTimer GlobalTimer;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+Animation_Frame_t AnimationClass::_Frames[2][Animation_MaxFrames];
+uint8_t AnimationClass::_Active = 0;
+uint8_t AnimationClass::_FrameCount = 0;
+uint8_t AnimationClass::_Playback = Animation_Loop;
+uint8_t AnimationClass::_Index = 0;
+int8_t AnimationClass::_Step = 1;
+int AnimationClass::_TID = -1;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+
+//=============================================================================
+// Animation::Load
+//
+// Replace the frame list from one line of text, so that a whole animation
+// arrives in a single Vpin write.
+//   <playback> <frame>[/<ms>] <frame>[/<ms>] ...
+// playback is O (once), L (loop) or P (ping-pong).
+// frame is 16 hex digits for a narrow frame or 24 for a wide frame.
+// ms is the time the frame is shown, Animation_DefaultFrameMs if missing.
+// Input:
+//	  text - The animation.
+// Output:
+//	  bool - false if the text is not valid, the old animation is kept.
+// The frames are parsed into the copy not being played, not onto the stack,
+// as this runs inside a Blynk write handler.
+//-----------------------------------------------------------------------------
+bool AnimationClass::Load(const char *text) {
+    Animation_Frame_t *const frames = _Frames[_Active ^ 1];
+    uint8_t count = 0;
+    uint8_t playback;
+
+    if (text == NULL)
+        return false;
+
+    switch (*text++) {
+        case 'O': case 'o': playback = Animation_Once;      break;
+        case 'L': case 'l': playback = Animation_Loop;      break;
+        case 'P': case 'p': playback = Animation_PingPong;  break;
+        default:            return false;
+    }
+
+    while (*text) {
+        if (*text == ' ' || *text == ',') {
+            text++;
+            continue;
+        }
+
+        if (count >= Animation_MaxFrames)
+            return false;
+
+        Animation_Frame_t *const frame = &frames[count];
+        uint8_t digits = 0;
+        frame->Low = 0;
+        frame->High = 0;
+
+        // Shift each hex digit into the 96 bit frame.
+        int8_t nibble;
+        while ((nibble = Format.HexDigit(*text)) >= 0) {
+            frame->High = (frame->High << 4) | (uint32_t)(frame->Low >> 60);
+            frame->Low = (frame->Low << 4) | nibble;
+            digits++;
+            text++;
+        }
+
+        if (digits != 16 && digits != 24)
+            return false;
+
+        frame->Wide = digits == 24;
+        frame->DurationMs = Animation_DefaultFrameMs;
+
+        if (*text == '/') {
+            char *end;
+            unsigned long const ms = strtoul(++text, &end, 10);
+
+            if (end == text)
+                return false;
+
+            frame->DurationMs = ms < Animation_MinFrameMs ? Animation_MinFrameMs : (ms > 60000 ? 60000 : ms);
+            text = end;
+        }
+
+        count++;
+    }
+
+    if (count == 0)
+        return false;
+
+    bool const playing = IsPlaying();
+
+    Stop();
+    _Active ^= 1;
+    _FrameCount = count;
+    _Playback = playback;
+
+    if (playing)
+        Start();
+
+    return true;
+}
+
+// Play from the first frame.
+void AnimationClass::Start() {
+    Stop();
+
+    if (_FrameCount == 0)
+        return;
+
+    _Index = 0;
+    _Step = 1;
+    Prepare();
+    NextFrame();
+}
+
+void AnimationClass::Stop() {
+    if (_TID != -1) {
+        GlobalTimer.deleteTimer(_TID);
+        _TID = -1;
+    }
+}
+
+// private:
+// Show the frame that is already prepared, then prepare the one after it while
+// waiting, so the timer only has to copy a ready frame onto the display.
+void AnimationClass::NextFrame() {
+    _TID = -1;
+    Display.CommitFrame();
+
+    uint16_t const durationMs = _Frames[_Active][_Index].DurationMs;
+
+    if (!Advance())
+        return;
+
+    _TID = GlobalTimer.setTimeout(durationMs, NextFrame);
+    Prepare();
+}
+
+// Move to the next frame. Returns false when a once through animation has ended.
+bool AnimationClass::Advance() {
+    if (_FrameCount == 1)
+        return _Playback != Animation_Once;
+
+    if (_Playback == Animation_PingPong) {
+        if ((_Step > 0 && _Index + 1 >= _FrameCount) || (_Step < 0 && _Index == 0))
+            _Step = -_Step;
+
+        _Index += _Step;
+        return true;
+    }
+
+    if (_Index + 1 < _FrameCount) {
+        _Index++;
+        return true;
+    }
+
+    _Index = 0;
+    return _Playback == Animation_Loop;
+}
+
+void AnimationClass::Prepare() {
+    Animation_Frame_t const *const frame = &_Frames[_Active][_Index];
+    Display.PrepareFrame(frame->Low, frame->High, frame->Wide);
+}
+
+// Animation.cpp EOF
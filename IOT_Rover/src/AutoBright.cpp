@@ -0,0 +1,166 @@
+//////////////////////////////// AutoBright.cpp ///////////////////////////////
+// Filename:	AutoBright.cpp
+// Description: Follow the ambient light with the display brightness.
+// Author:		Danon Bradford
+// Date:		2020-04-25
+//////////////////////////////// AutoBright.cpp ///////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include "Display.h"				// Display Header file
+#include "AutoBright.h"				// Source Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+// #define AutoBright_Debug    1   // Print every level change
+
+#define LevelUnknown        0xFF
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+AutoBrightClass AutoBright;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+bool AutoBrightClass::_Enabled = false;
+
+// _Threshold[n] is the lux needed to reach level n + 1.
+float AutoBrightClass::_Threshold[AutoBright_Levels - 1] = {0};
+
+// The manual level, the curve level and the level the display was last given.
+uint8_t AutoBrightClass::_Manual = 7;
+uint8_t AutoBrightClass::_Level = LevelUnknown;
+uint8_t AutoBrightClass::_Issued = LevelUnknown;
+
+uint32_t AutoBrightClass::_Changes = 0;
+uint32_t AutoBrightClass::_LastUpdateMs = 0;
+float AutoBrightClass::_SavedMah = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+void AutoBrightClass::Enable(bool const onOff) {
+    _Enabled = onOff;
+    _Level = LevelUnknown;
+    _LastUpdateMs = 0;
+
+    if (_Threshold[0] == 0)
+        SetCurve(AutoBright_DarkLux, AutoBright_BrightLux);
+
+    // Back to the manual level straight away, the curve waits for a reading.
+    if (!onOff) {
+        _Issued = _Manual;
+        Display.SetBrightness(_Manual);
+    }
+}
+
+//=============================================================================
+// AutoBright::SetCurve
+//
+// Space the levels evenly on a log scale, each step a fixed ratio of lux.
+// Input:
+//	  darkLux   - At or below this the display is at level 0, at least 1 lux.
+//    brightLux - At or above this the display is at level 15.
+//-----------------------------------------------------------------------------
+void AutoBrightClass::SetCurve(float const darkLux, float const brightLux) {
+    float const dark = darkLux < 1.0f ? 1.0f : darkLux;
+    float const bright = brightLux < dark * 2 ? dark * 2 : brightLux;
+    float const step = powf(bright / dark, 1.0f / (AutoBright_Levels - 1));
+    float threshold = dark;
+
+    for (uint8_t level = 0; level < AutoBright_Levels - 1; level++) {
+        threshold *= step;
+        _Threshold[level] = threshold;
+    }
+
+    // Find the level on the new curve from the next reading.
+    _Level = LevelUnknown;
+}
+
+// The brightness asked for by the user. It is used as is while the curve is
+// off, otherwise it is the brightest the curve can go.
+void AutoBrightClass::SetManual(uint8_t const level) {
+    _Manual = level & 0x0F;
+
+    if (_Enabled) {
+        Issue();
+    } else {
+        _Issued = _Manual;
+        Display.SetBrightness(_Manual);
+    }
+}
+
+// Give the latest ambient light reading, about once a second.
+void AutoBrightClass::Update(float const lux) {
+    if (!_Enabled)
+        return;
+
+    uint32_t const nowMs = millis();
+
+    if (_Level == LevelUnknown) {
+        // No level to hold yet, go straight to the curve.
+        _Level = 0;
+        while (_Level < AutoBright_Levels - 1 && lux >= _Threshold[_Level])
+            _Level++;
+    } else if (_Level < AutoBright_Levels - 1 && lux >= _Threshold[_Level] * AutoBright_Hysteresis) {
+        _Level++;
+    } else if (_Level > 0 && lux < _Threshold[_Level - 1] / AutoBright_Hysteresis) {
+        _Level--;
+    }
+
+    // Current saved since the last reading, the level shown against the manual level.
+    if (_LastUpdateMs != 0 && _Issued <= _Manual) {
+        float const seconds = (nowMs - _LastUpdateMs) / 1000.0f;
+        _SavedMah += (MicroAmps(_Manual) - MicroAmps(_Issued)) * seconds / 3.6e6f;
+    }
+    _LastUpdateMs = nowMs;
+
+    Issue();
+
+#ifdef AutoBright_Debug
+    static uint32_t lastChanges = 0;
+    if (_Changes != lastChanges) {
+        lastChanges = _Changes;
+        Serial.printf("Auto brightness %u at %d lx\n", _Issued, (int)lux);
+        PrintStats();
+    }
+#endif
+}
+
+void AutoBrightClass::PrintStats() {
+    uint8_t const level = _Issued < AutoBright_Levels ? _Issued : _Manual;
+    uint32_t const milliAmps = (uint32_t)(MicroAmps(level) / 1000);
+    uint32_t const savedMicroAh = (uint32_t)(_SavedMah * 1000);
+
+    Serial.printf("Auto brightness: %s, level %u of %u, %u changes\n",
+                  _Enabled ? "on" : "off", level, _Manual, _Changes);
+    Serial.printf("Display about %u mA now, %u.%03u mAh saved\n",
+                  milliAmps, savedMicroAh / 1000, savedMicroAh % 1000);
+}
+
+// private:
+// The display current at a dimming level, level n lights each LED for n + 1
+// sixteenths of the time.
+float AutoBrightClass::MicroAmps(uint8_t const level) {
+    return (float)Display.LitPixels() * AutoBright_LedMicroAmps * (level + 1) / AutoBright_Levels;
+}
+
+// Only send the dimming command when the level changes.
+void AutoBrightClass::Issue() {
+    uint8_t const level = _Level < _Manual ? _Level : _Manual;
+
+    if (level == _Issued)
+        return;
+
+    _Issued = level;
+    _Changes++;
+    Display.SetBrightness(level);
+}
+
+// AutoBright.cpp EOF
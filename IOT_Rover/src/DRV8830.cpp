@@ -10,14 +10,14 @@
 // ----------------------------------------------------------------------------
 #include "DRV8830.h"  // Source Header file
 #include <Arduino.h>  // Arduino Header file
-#include <Wire.h>     // I2C Header file
+#include "I2CBus.h"   // I2C Transaction Header file
 
 //*****************************************************************************
 // Private Macro Definitions
 //-----------------------------------------------------------------------------
 #define VsetMax 0x3Fu               // 63
 #define VsetMin 0x06u               //  6
-#define MaxSpeed VsetMax - VsetMin  // 57
+#define MaxSpeed DRV8830_MaxSpeed   // VsetMax - VsetMin
 // #define DRV8830_Debug 1
 
 //=============================================================================
@@ -30,10 +30,13 @@ bool DRV8830Class::WriteRegByte(DRV8830_Register const reg,
     Serial.print(String("DRV8830Class::WriteRegByte(" + String(reg, HEX) +
                         ", " + String(byte, HEX) + ") = "));
 #endif
-    Wire.beginTransmission(this->_I2CAddr);
+    I2CBus_Trans_t trans;
+    I2CBus.Init(&trans, this->_I2CAddr, I2CBus_Write, I2CBus_PriorityMotor);
+    trans.TxData[0] = reg;
+    trans.TxData[1] = byte;
+    trans.TxLen = 2;
 
-    if (Wire.write(reg) == 1 && Wire.write(byte) == 1 &&
-        Wire.endTransmission(true) == 0) {
+    if (I2CBus.Transact(&trans)) {
 #ifdef DRV8830_Debug
         Serial.println("true");
 #endif
@@ -51,23 +54,46 @@ bool DRV8830Class::GetFaultReg(uint8_t *const dataPtr) {
     Serial.print(String("DRV8830Class::GetFaultReg(" +
                         String((uint32_t)dataPtr, HEX) + ") = "));
 #endif
-    Wire.beginTransmission(this->_I2CAddr);
+    uint8_t data = 0;
+    I2CBus_Trans_t trans;
+    I2CBus.Init(&trans, this->_I2CAddr, I2CBus_WriteRead, I2CBus_PriorityMotor);
+    trans.TxData[0] = DRV8830_Fault;
+    trans.TxLen = 1;
+    trans.RxPtr = &data;
+    trans.RxLen = 1;
 
-    if (Wire.write(DRV8830_Fault) == 1 && Wire.endTransmission(0x00u) == 0 &&
-        Wire.requestFrom(this->_I2CAddr, 0x01u, 0x01u) == 1) {
-        if (dataPtr) *dataPtr = Wire.read();
+    if (I2CBus.Transact(&trans)) {
+        // The bits stay set until cleared, count a fault once.
+        if ((data & DRV8830_FaultBit) && !_FaultSeen) {
+            _FaultSeen = true;
+            _FaultMs = millis();
+            _LastFault = data;
+            if (data & DRV8830_FaultOcp) _FaultCounts[DRV8830_Ocp]++;
+            if (data & DRV8830_FaultUvlo) _FaultCounts[DRV8830_Uvlo]++;
+            if (data & DRV8830_FaultOts) _FaultCounts[DRV8830_Ots]++;
+            if (data & DRV8830_FaultILimit) _FaultCounts[DRV8830_ILimit]++;
+        }
+        if (dataPtr) *dataPtr = data;
 #ifdef DRV8830_Debug
-        Serial.println("true, " + String(*dataPtr, HEX));
+        Serial.println("true, " + String(data, HEX));
 #endif
         return true;
     }
 #ifdef DRV8830_Debug
-    Serial.println("false, " + String(*dataPtr, HEX));
+    Serial.println("false");
 #endif
     return false;
 }
 
-bool DRV8830Class::ClearFaultReg() { return WriteRegByte(DRV8830_Fault, 0x80); }
+// The chip stops driving on a fault until it is cleared, then the control
+// value is written again.
+bool DRV8830Class::ClearFaultReg() {
+    if (!WriteRegByte(DRV8830_Fault, DRV8830_FaultClear)) return false;
+
+    _FaultSeen = false;
+    _AckedValid = false;
+    return true;
+}
 
 // The speed (VSET) and bridge control share the same register
 //  D7 - D2    D1    D0
@@ -93,8 +119,18 @@ void DRV8830Class::SetSpeedDir(int8_t const speed) {
 
 void DRV8830Class::SetCoast() { this->_ControlReg = 0x00u; }
 
+void DRV8830Class::SetBrake() { this->_ControlReg = DRV8830_Brake; }
+
 bool DRV8830Class::WriteControlReg() {
-    return WriteRegByte(DRV8830_Control, this->_ControlReg);
+    if (this->_AckedValid && this->_AckedReg == this->_ControlReg) {
+        this->_WritesSuppressed++;
+        return true;
+    }
+
+    this->_WritesIssued++;
+    this->_AckedValid = WriteRegByte(DRV8830_Control, this->_ControlReg);
+    this->_AckedReg = this->_ControlReg;
+    return this->_AckedValid;
 }
 
 // DRV8830.cpp EOF
\ No newline at end of file
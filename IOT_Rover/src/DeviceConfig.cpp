@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #include <Blynk/BlynkTimer.h>   
 #include "Planque.h"
+#include "LightGrid.h"
 #include "DeviceConfig.h"
 
 //*****************************************************************************
@@ -134,7 +135,7 @@ void DeviceConfigClass::EraseNv() {
     NV_PersonName[0] = '\0';
     NV_ProductConfigArray[0] = 0;
     NV_ProductConfigArray[1] = DC_PC1_Default;
-    NV_ProductConfigArray[2] = 0;
+    NV_ProductConfigArray[2] = DC_PC2_Default;
     NV_ProductConfigArray[3] = 0;
 }
 
@@ -161,6 +162,26 @@ DC_Power DeviceConfigClass::getPower() {
     return (DC_Power)Decipher_Product_Config_1(DC_Power_Pos, DC_Power_Len);
 }
 
+DC_Rates DeviceConfigClass::getRates() { 
+    return (DC_Rates)Decipher_Product_Config_1(DC_Rates_Pos, DC_Rates_Len);
+}
+
+DC_I2C DeviceConfigClass::getI2C() { 
+    return (DC_I2C)Decipher_Product_Config_1(DC_I2C_Pos, DC_I2C_Len);
+}
+
+uint8_t DeviceConfigClass::getPanels() { 
+    return Decipher_Product_Config_1(DC_Panels_Pos, DC_Panels_Len) + 1;
+}
+
+DC_Bright DeviceConfigClass::getBright() { 
+    return (DC_Bright)Decipher_Product_Config_1(DC_Bright_Pos, DC_Bright_Len);
+}
+
+uint32_t DeviceConfigClass::getPanelOrder() { 
+    return NV_ProductConfigArray[2] ? NV_ProductConfigArray[2] : LightGrid_NaturalOrder;
+}
+
 // private:
 uint32_t DeviceConfigClass::ReverseBitsU32(uint32_t n) {
     n = ((n >> 1) & 0x55555555) | ((n << 1) & 0xaaaaaaaa);
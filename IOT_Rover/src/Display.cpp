@@ -10,7 +10,9 @@
 //-----------------------------------------------------------------------------
 #include <Arduino.h>				// Arduino Header file
 #include <Blynk/BlynkTimer.h>   
-#include "AsciiArray.h"				// Ascii Array Header file
+#include "BitMatrix.h"				// Bit Matrix Header file
+#include "Font.h"					// Font Header file
+#include "Format.h"					// Format Header file
 #include "Display.h"				// Source Header file
 
 //*****************************************************************************
@@ -23,34 +25,20 @@ DisplayClass Display;
 //-----------------------------------------------------------------------------
 extern BlynkTimer GlobalTimer;
 
-//*****************************************************************************
-// Private Global Variables
-//-----------------------------------------------------------------------------
-// Fastest way to reverse the bits in a U8
-static const uint8_t ReverseU8[] = {
-  0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0, 
-  0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8, 
-  0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4, 
-  0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC, 
-  0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2, 
-  0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
-  0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6, 
-  0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
-  0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
-  0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9, 
-  0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
-  0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
-  0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3, 
-  0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
-  0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7, 
-  0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
-};
-
 //*****************************************************************************
 // Class Member Variable Definitions (static)
 //-----------------------------------------------------------------------------
 int DisplayClass::_DispUpdaTID = -1;
 int DisplayClass::_TempStrTID = -1;
+
+// Idle power management. With no activity for _IdleTimeoutMs the display fades
+// out and the HT16K33 goes into standby, 0 keeps it on.
+int DisplayClass::_IdleTID = -1;
+uint32_t DisplayClass::_IdleTimeoutMs = 0;
+uint8_t DisplayClass::_IdleState = Display_Awake;
+uint8_t DisplayClass::_Brightness = 7;
+uint8_t DisplayClass::_FadeLevel = 0;
+bool DisplayClass::_ScrollWanted = true;
 uint8_t DisplayClass::_Mode[2] = {Display_String_Mode, Display_String_Mode};
 uint8_t DisplayClass::_Show = Display_PRIMARY_Show;
 uint8_t DisplayClass::_Rotation = 0x03;
@@ -58,17 +46,85 @@ uint8_t DisplayClass::_Rotation = 0x03;
 // Buffer for scrolling text modes.
 uint8_t DisplayClass::_StringCharArray[2][50] = {32};
 uint8_t DisplayClass::_StringLength[2] = {0};
-uint64_t DisplayClass::_U64ImageArray[2][9] = {0};
+uint64_t DisplayClass::_U64ImageArray[2][Display_U64Images] = {0};
 uint8_t DisplayClass::_U64ImageCount[2] = {0};
 
 // Scrolling text variables.
-uint8_t DisplayClass::_ScrollElement = 0;
-uint8_t DisplayClass::_ScrollWindow = 0;
+uint16_t DisplayClass::_ScrollOffset = 0;
+
+// The panels make one canvas, _Width columns along the scroll.
+// The message starts and ends _LeadIn blank columns away, so it enters and
+// leaves the canvas from off the edge.
+uint8_t DisplayClass::_Width = Display_PanelWidth;
+uint8_t DisplayClass::_LeadIn = Display_PanelWidth + Display_LeadInExtra;
+
+// #define Display_Bench       1   // Print the average cycles per scroll tick
+
+// The whole message pre-rendered for the current rotation.
+// One bit stream per display column, LSB first along the scroll direction.
+// A scroll tick copies a 12 bit window out of each stream.
+// Text scrolled sideways uses the proportional font, so a glyph only takes
+// the columns it needs.
+uint8_t DisplayClass::_Strip[8][Display_StripBytes] = {{0}};
+uint16_t DisplayClass::_StripBits = 0;
+uint16_t DisplayClass::_StripEnd = 0;
+uint8_t DisplayClass::_StripShow = 0xFF;
+uint8_t DisplayClass::_StripMode = 0xFF;
+uint8_t DisplayClass::_StripRotation = 0xFF;
+bool DisplayClass::_StripDirty = true;
+
+// The next animation frame, ready to be copied to the display.
+uint16_t DisplayClass::_FrameNext[8] = {0};
+
+// Streamed text, a ring of characters that have not been drawn yet.
+// The drawn columns wait in a ring of bits per display column, in scroll
+// order, bit _StreamPos is the column at the leading edge of the canvas.
+char DisplayClass::_StreamRing[Display_StreamSize];
+uint8_t DisplayClass::_StreamHead = 0;
+uint8_t DisplayClass::_StreamCount = 0;
+Display_StreamSourceFn DisplayClass::_StreamSource = NULL;
+uint8_t DisplayClass::_StreamBits[8][Display_StreamBitBytes] = {{0}};
+uint8_t DisplayClass::_StreamPos = 0;
+uint8_t DisplayClass::_StreamFill = Display_PanelWidth;
+uint8_t DisplayClass::_StreamRotation = 0xFF;
+#ifdef Display_Bench
+static uint32_t BenchCycles = 0;
+static uint16_t BenchTicks = 0;
+#endif
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static uint16_t Reverse12(uint16_t x) {
+    x = ((x >> 1) & 0x5555) | ((x & 0x5555) << 1);
+    x = ((x >> 2) & 0x3333) | ((x & 0x3333) << 2);
+    x = ((x >> 4) & 0x0F0F) | ((x & 0x0F0F) << 4);
+    x = (x >> 8) | (x << 8);
+    return x >> 4;
+}
+
+// 12 bits from a ring of Display_StreamBitBytes bytes, starting at bit.
+static uint16_t RingWindow(uint8_t const *const ring, uint8_t const bit) {
+    uint8_t const index = (bit >> 3) % Display_StreamBitBytes;
+    uint32_t const bits = ((uint32_t)ring[index] << 0) |
+                          ((uint32_t)ring[(index + 1) % Display_StreamBitBytes] << 8) |
+                          ((uint32_t)ring[(index + 2) % Display_StreamBitBytes] << 16);
+    return (uint16_t)(bits >> (bit & 0x07)) & 0x0FFF;
+}
 
 //=============================================================================
 // Class Member Method Definitions (static)
 //-----------------------------------------------------------------------------
 // public:
+// Chain count panels into one canvas, see LightGrid::SetPanels. Call before Init.
+void DisplayClass::SetPanels(uint8_t const count, uint32_t const order) {
+    _LightGrid.SetPanels(count, order);
+    _Width = _LightGrid.PanelCount() * Display_PanelWidth;
+    _LeadIn = _Width + Display_LeadInExtra;
+    _StreamFill = _Width;
+    _StripDirty = true;
+}
+
 bool DisplayClass::Init(void) {
     _LightGrid.Init();
 
@@ -78,27 +134,28 @@ bool DisplayClass::Init(void) {
     // Power on the Light Grid, 
     // Turn on the display and
     // Set the brightness to the highest level.
-    // Return true if all this worked!
-    return (
+    // The commands are queued, send them now to see if they all worked!
+    uint32_t const errors = _LightGrid.CommandErrors;
+    bool const queued = (
         _LightGrid.Power(1) 			&&
         _LightGrid.Display(1) 			&&
-        _LightGrid.Brightness(7)	
+        _LightGrid.Brightness(_Brightness)	
     );
+    I2CBus.Run();
+
+    return queued && _LightGrid.CommandErrors == errors;
 }
 
 void DisplayClass::UpdateRotation(uint8_t const rotation) {
-    static uint8_t prevRotation = 0x03;
+    // Bit 6 is set while the orientation is not known, keep the last one.
+    if ((rotation & 0x40) || (rotation & 0x03) == _Rotation)
+        return;
 
-    if (!(rotation&0x40)) {
-        _Rotation = rotation & 0x03;
-
-        if (_Rotation != prevRotation) {
-            prevRotation = _Rotation;
-            CheckActIfScrollEnabled();
-        }
-    }	
+    _Rotation = rotation & 0x03;
+    CheckActIfScrollEnabled();
 }
 void DisplayClass::SetMode(uint8_t const show, uint8_t const mode) {
+    Wake();
     _Mode[show] = mode;
 
     if (show == Display_PRIMARY_Show) {
@@ -124,10 +181,21 @@ void DisplayClass::SetMode(uint8_t const show, uint8_t const mode) {
     }
 }
 
-void DisplayClass::SetString(uint8_t const show, String textString) {
-    _StringLength[show] = textString.length();
+void DisplayClass::SetString(uint8_t const show, const char *text) {
+    uint8_t length = 0;
+    bool changed = false;
+
+    while (length < Display_MaxStringLength && text[length]) {
+        changed |= _StringCharArray[show][2 + length] != (uint8_t)text[length];
+        _StringCharArray[show][2 + length] = text[length];
+        length++;
+    }
+
+    // A sensor showing the same reading again is not new text.
+    if (!changed && length == _StringLength[show])
+        return;
 
-    textString.toCharArray((char*)&_StringCharArray[show][2], 45);
+    _StringLength[show] = length;
 
     // Make sure the first characters are blank
     _StringCharArray[show][0] = 32;
@@ -138,24 +206,39 @@ void DisplayClass::SetString(uint8_t const show, String textString) {
     _StringCharArray[show][2 + _StringLength[show] + 1] = 32;
     _StringCharArray[show][2 + _StringLength[show] + 2] = 32;
 
+    _StripDirty = true;
+    Wake();
     CheckActIfScrollEnabled();
 }
 
 void DisplayClass::SetNumber(uint8_t const show, int const number) {
-    SetString(show, String(number,DEC));
+    char text[Format_NumberSize];
+
+    Format.Int(text, sizeof(text), 0, number);
+    SetString(show, text);
 }
 
 void DisplayClass::SetU64Image(uint8_t const show, uint64_t const image, uint8_t const index) {
+    if (index + 2 >= Display_U64Images || _U64ImageArray[show][index+2] == image)
+        return;
+
     _U64ImageArray[show][index+2] = image;	
+    _StripDirty = true;
 }
 
 void DisplayClass::SetU64Count(uint8_t const show, uint8_t const count) {
+    Wake();
     _U64ImageCount[show] = count;
+    _StripDirty = true;
     CheckActIfScrollEnabled();
 }
 
+// Kept for when the display wakes, if it is fading or in standby.
 void DisplayClass::SetBrightness(const uint8_t bright) {
-    _LightGrid.Brightness(bright);
+    _Brightness = bright & 0x0F;
+
+    if (_IdleState == Display_Awake)
+        _LightGrid.Brightness(_Brightness);
 }
 
 void DisplayClass::PixelsOnOff(const uint8_t onOff) {
@@ -165,6 +248,7 @@ void DisplayClass::PixelsOnOff(const uint8_t onOff) {
 void DisplayClass::ActivateTempShow(uint32_t msTime) {
 
     if (!msTime) return;
+    Wake();
     _Show = Display_TEMPORARY_Show;
 
     // Delete the timer if it's already running.
@@ -176,8 +260,7 @@ void DisplayClass::ActivateTempShow(uint32_t msTime) {
 }
 
 void DisplayClass::ScrollReset() {	
-    _ScrollWindow = 0;
-    _ScrollElement = 0;
+    _ScrollOffset = 0;
 }
 
 void DisplayClass::SetScrollInterval(uint32_t msTime) {
@@ -185,9 +268,10 @@ void DisplayClass::SetScrollInterval(uint32_t msTime) {
 }
 
 void DisplayClass::ScrollEnable(bool const onOff) {	
+    Wake();
+
     if (onOff) {
-        _ScrollWindow = 0;
-        _ScrollElement = 0;
+        _ScrollOffset = 0;
         GlobalTimer.enable(_DispUpdaTID);
     } else {
         GlobalTimer.disable(_DispUpdaTID);
@@ -203,72 +287,227 @@ void DisplayClass::Invert() {
     _LightGrid.InvertBuffer();
 }
 
+// y runs along the whole canvas, on from one panel to the next.
 void DisplayClass::SetPixel(uint8_t const x, uint8_t const y, uint8_t const onOff) {
-    return _LightGrid.SetPixel(x, y, onOff);
+    Wake();
+    return _LightGrid.SetPixel(y / Display_PanelWidth, x, y % Display_PanelWidth, onOff);
 }
 
 void DisplayClass::SetAllPixelsOn() {
-    for (uint8_t count = 0; count < 8; count++) {
-        _LightGrid.SetColumn(count, 0xFFFF);
+    for (uint8_t panel = 0; panel < _LightGrid.PanelCount(); panel++) {
+        for (uint8_t count = 0; count < 8; count++) {
+            _LightGrid.SetColumn(panel, count, 0xFFFF);
+        }
     }
     WriteBuffer();
 }
 
 void DisplayClass::ManualWriteStringStart() {
+    if (_IdleState == Display_Standby) return;
+
+    if (_Mode[_Show] == Display_Stream_Mode) {
+        StreamTick(false);
+        _LightGrid.WriteBuffer();
+        return;
+    }
+
     if (_Mode[_Show] != Display_String_Mode && _Mode[_Show] != Display_U64_Mode) return;
 
-    uint8_t stringLength = _Mode[_Show] == Display_U64_Mode ? _U64ImageCount[_Show] : _StringLength[_Show];
+    UpdateStrip();
 
-    if (stringLength == 1)
-        LoadPartOfString(1,6);
+    // Centre a message that fits on the display, otherwise start with it against the edge.
+    uint16_t const textBits = _StripEnd - _LeadIn;
+
+    if (textBits <= _Width)
+        LoadWindow(_LeadIn - (_Width - textBits) / 2);
     else
-        LoadPartOfString(2,0);
+        LoadWindow(_LeadIn);
 
     _LightGrid.WriteBuffer();
 }
 
+// Nothing is sent in standby, Wake() sends the buffer as it is then.
 void DisplayClass::WriteBuffer() {
+    if (_IdleState != Display_Standby)
+        _LightGrid.WriteBuffer();
+}
+
+// Render an animation frame into the back buffer, the display is not changed.
+// A narrow 8x8 frame is turned for the rotation and drawn in the middle.
+void DisplayClass::PrepareFrame(uint64_t const low, uint32_t const high, bool const wide) {
+    if (wide) {
+        for (uint8_t column = 0; column < 8; column++) {
+            uint8_t const bit = column * 12;
+            uint64_t const bits = bit < 64 ? (low >> bit) | (bit > 52 ? (uint64_t)high << (64 - bit) : 0) : high >> (bit - 64);
+            _FrameNext[column] = (uint16_t)bits & 0x0FFF;
+        }
+    } else {
+        uint64_t const image = OrientGlyph(low);
+
+        for (uint8_t column = 0; column < 8; column++)
+            _FrameNext[column] = (uint16_t)((uint8_t)(image >> (column * 8))) << 2;
+    }
+}
+
+// Copy the back buffer to the middle of the canvas, if an animation is being shown.
+void DisplayClass::CommitFrame() {
+    if (_Mode[_Show] != Display_Animation_Mode || _IdleState == Display_Standby) return;
+
+    int8_t const left = (_Width - Display_PanelWidth) / 2;
+
+    for (uint8_t panel = 0; panel < _LightGrid.PanelCount(); panel++) {
+        // Where the frame starts on this panel, it may be cut by a panel edge.
+        int8_t const shift = left - panel * Display_PanelWidth;
+
+        for (uint8_t column = 0; column < 8; column++) {
+            uint16_t bits = 0;
+
+            if (shift >= 0 && shift < Display_PanelWidth)
+                bits = _FrameNext[column] << shift;
+            else if (shift < 0 && shift > -Display_PanelWidth)
+                bits = _FrameNext[column] >> -shift;
+
+            _LightGrid.SetColumn(panel, column, bits & 0x0FFF);
+        }
+    }
+
     _LightGrid.WriteBuffer();
 }
 
+// Add text to the end of the stream. Returns the number of characters taken,
+// less than the length if the ring is full.
+uint8_t DisplayClass::StreamAppend(const char *text) {
+    return StreamAppend(text, strnlen(text, Display_StreamSize));
+}
+
+uint8_t DisplayClass::StreamAppend(const char *text, uint8_t const length) {
+    uint8_t taken = 0;
+
+    if (length)
+        Wake();
+
+    while (taken < length && _StreamCount < Display_StreamSize) {
+        _StreamRing[(_StreamHead + _StreamCount) % Display_StreamSize] = text[taken++];
+        _StreamCount++;
+    }
+
+    return taken;
+}
+
+// Drop the waiting text and blank the display, the next text starts at the trailing edge.
+void DisplayClass::StreamClear() {
+    _StreamHead = 0;
+    _StreamCount = 0;
+    _StreamPos = 0;
+    _StreamFill = _Width;
+    memset(_StreamBits, 0, sizeof(_StreamBits));
+}
+
+void DisplayClass::SetStreamSource(Display_StreamSourceFn const source) {
+    _StreamSource = source;
+}
+
+// Seconds without activity before the display fades out, 0 to stay on.
+void DisplayClass::SetIdleTimeout(uint32_t const seconds) {
+    if (_IdleState == Display_Awake && _IdleTID != -1) {
+        GlobalTimer.deleteTimer(_IdleTID);
+        _IdleTID = -1;
+    }
+
+    _IdleTimeoutMs = seconds * 1000;
+    Wake();
+}
+
+// Activity, bring the display straight back and start the idle time again.
+// A switch press or an accelerometer tap calls this, as do the Display calls
+// that show something new.
+void DisplayClass::Wake() {
+    if (_IdleState != Display_Awake) {
+        if (_IdleTID != -1) {
+            GlobalTimer.deleteTimer(_IdleTID);
+            _IdleTID = -1;
+        }
+
+        bool const standby = _IdleState == Display_Standby;
+
+        if (standby) {
+            _LightGrid.Power(1);
+
+            if (_ScrollWanted)
+                GlobalTimer.enable(_DispUpdaTID);
+        }
+
+        _LightGrid.Brightness(_Brightness);
+        _IdleState = Display_Awake;
+
+        // Nothing was drawn in standby, catch up with what changed.
+        if (standby) {
+            CheckActIfScrollEnabled();
+            _LightGrid.WriteBuffer();
+        }
+    }
+
+    RestartIdle();
+}
+
 // private:
-void DisplayClass::LoadPartOfString(uint8_t const element, uint8_t const window) {
+void DisplayClass::LoadWindow(uint16_t offset) {
     
-    if (_Mode[_Show] == Display_U64_Mode) {
-        uint64_t *arrayPtr = _U64ImageArray[_Show];
-        SetTrippleImage64(arrayPtr[element+0], arrayPtr[element+1], arrayPtr[element+2], window);
-    } else {
-        uint64_t aa = AsciiArray[_StringCharArray[_Show][element+0]];
-        uint64_t bb = AsciiArray[_StringCharArray[_Show][element+1]];
-        uint64_t cc = AsciiArray[_StringCharArray[_Show][element+2]];
-        // String hexString = String((uint32_t)(aa>>32) ,HEX) + String((uint32_t)aa ,HEX);
-        // while (hexString.length() < 16) {
-        //     hexString = String("0") + hexString;
-        // }
-        // Serial.println(String("aa = ") + hexString);
-        SetTrippleImage64(aa, bb, cc, window);
+    UpdateStrip();
+
+    if (offset > _StripBits - _Width)
+        offset = _StripBits - _Width;
+
+    // Rotations 1 and 3 are stored back to front, so that the window is a plain shift.
+    // The chain of panels is then back to front too, panel 0 takes the end of the window.
+    if (_Rotation & 0x01)
+        offset = _StripBits - _Width - offset;
+
+    for (uint8_t panel = 0; panel < _LightGrid.PanelCount(); panel++) {
+        uint16_t const at = offset + panel * Display_PanelWidth;
+        uint8_t const index = at >> 3;
+        uint8_t const shift = at & 0x07;
+
+        for (uint8_t column = 0; column < 8; column++) {
+            uint8_t const *const stream = &_Strip[column][index];
+            uint32_t const bits = ((uint32_t)stream[0] << 0) | ((uint32_t)stream[1] << 8) | ((uint32_t)stream[2] << 16);
+            _LightGrid.SetColumn(panel, column, (uint16_t)(bits >> shift) & 0x0FFF);
+        }
     }
 }
 
+// Redraw now if the scroll timer will not, and never in standby.
 void DisplayClass::CheckActIfScrollEnabled() {
-    if (!GlobalTimer.isEnabled(_DispUpdaTID))	
+    if (_IdleState != Display_Standby && !GlobalTimer.isEnabled(_DispUpdaTID))	
         ManualWriteStringStart();
 }
 
 void DisplayClass::ScrollString() {
 
+    if (_Mode[_Show] == Display_Stream_Mode) {
+        StreamTick(true);
+        _LightGrid.WriteBuffer();
+        return;
+    }
+
     if (_Mode[_Show] != Display_String_Mode && _Mode[_Show] != Display_U64_Mode) return;
     
-    LoadPartOfString(_ScrollElement, _ScrollWindow++);	
-    
-    uint8_t stringLength = _Mode[_Show] == Display_U64_Mode ? _U64ImageCount[_Show] : _StringLength[_Show];
-    if (_ScrollWindow > 8) {
-        _ScrollWindow = 1;
-        _ScrollElement++;
-
-        if (_ScrollElement > stringLength + 1)
-            _ScrollElement = 0;
+#ifdef Display_Bench
+    uint32_t const startCycles = ESP.getCycleCount();
+#endif
+    LoadWindow(_ScrollOffset++);	
+#ifdef Display_Bench
+    BenchCycles += ESP.getCycleCount() - startCycles;
+    if (++BenchTicks >= 256) {
+        Serial.printf("Display scroll %u cycles/tick\n", BenchCycles / BenchTicks);
+        BenchCycles = 0;
+        BenchTicks = 0;
     }
+#endif
+    
+    // Start again once the end of the message has scrolled off.
+    if (_ScrollOffset > _StripEnd)
+        _ScrollOffset = 1;
 
     _LightGrid.WriteBuffer();
 }
@@ -282,11 +521,199 @@ void DisplayClass::TempShowTimeout() {
         WriteBuffer();
     } else if (_Mode[_Show] == Display_AllLedsOn_Mode) {
         SetAllPixelsOn();            
+    } else if (_Mode[_Show] == Display_Animation_Mode) {
+        CommitFrame();
     }
 
     CheckActIfScrollEnabled();
 }
 
+void DisplayClass::RestartIdle() {
+    if (_IdleTimeoutMs == 0)
+        return;
+
+    if (_IdleTID == -1)
+        _IdleTID = GlobalTimer.setTimeout(_IdleTimeoutMs, IdleTimeout);
+    else
+        GlobalTimer.restartTimer(_IdleTID);
+}
+
+// Nothing new for the idle time, step the brightness down to the lowest level.
+void DisplayClass::IdleTimeout() {
+    _IdleTID = -1;
+
+    // Already dark, nothing to save.
+    if (_Mode[Display_PRIMARY_Show] == Display_PowerOff_Mode || _Mode[Display_PRIMARY_Show] == Display_DisplayOff_Mode)
+        return;
+
+    _IdleState = Display_Fading;
+    _FadeLevel = _Brightness;
+    _IdleTID = GlobalTimer.setTimer(Display_FadeStepMs, IdleFade, _Brightness + 1);
+}
+
+// One step of the fade. The last step stops the oscillator and the scroll
+// timer, so the display costs no bus or CPU time until it wakes.
+void DisplayClass::IdleFade() {
+    if (_FadeLevel > 0) {
+        _LightGrid.Brightness(--_FadeLevel);
+        return;
+    }
+
+    _IdleTID = -1;
+    _IdleState = Display_Standby;
+    _ScrollWanted = GlobalTimer.isEnabled(_DispUpdaTID);
+    GlobalTimer.disable(_DispUpdaTID);
+    _LightGrid.Power(0);
+}
+
+void DisplayClass::UpdateStrip() {
+    if (_StripDirty || _StripShow != _Show || _StripMode != _Mode[_Show] || _StripRotation != _Rotation)
+        RenderStrip();
+}
+
+// Render every glyph of the message being shown into _Strip.
+// The strip holds _LeadIn blank columns, the message and then blanks to the end.
+void DisplayClass::RenderStrip() {
+    bool const u64Mode = _Mode[_Show] == Display_U64_Mode;
+    uint8_t const length = u64Mode ? _U64ImageCount[_Show] : _StringLength[_Show];
+
+    // In landscape text moves along the glyph width, so it can be packed up.
+    // In portrait it moves along the glyph height and keeps the 8x8 cell.
+    bool const proportional = !u64Mode && (_Rotation & 0x02);
+
+    _StripShow = _Show;
+    _StripMode = _Mode[_Show];
+    _StripRotation = _Rotation;
+    _StripDirty = false;
+
+    // Leave room for a blank display after the message.
+    uint16_t textBits = 0;
+    uint8_t count = 0;
+
+    while (count < length && textBits + GlyphAdvance(count, proportional) <= Display_StripBits - 2 * _LeadIn) {
+        textBits += GlyphAdvance(count, proportional);
+        count++;
+    }
+
+    _StripEnd = _LeadIn + textBits;
+    _StripBits = _StripEnd + _LeadIn;
+    memset(_Strip, 0, sizeof(_Strip));
+
+    uint16_t position = _LeadIn;
+
+    for (uint8_t glyph = 0; glyph < count; glyph++) {
+        uint64_t image = 0;
+        uint8_t width;
+
+        if (u64Mode) {
+            if (glyph + 2 < Display_U64Images)
+                image = _U64ImageArray[_Show][glyph + 2];
+        } else {
+            image = Font.Image(_StringCharArray[_Show][glyph + 2], !proportional, &width);
+        }
+
+        image = OrientGlyph(image);
+
+        // Rotations 1 and 3 scroll the other way along the stream.
+        uint16_t const at = (_Rotation & 0x01) ? _StripBits - position - 8 : position;
+
+        for (uint8_t column = 0; column < 8; column++) {
+            uint16_t const bits = (uint16_t)(uint8_t)(image >> (column * 8)) << (at & 0x07);
+            _Strip[column][(at >> 3) + 0] |= (uint8_t)bits;
+            _Strip[column][(at >> 3) + 1] |= (uint8_t)(bits >> 8);
+        }
+
+        position += GlyphAdvance(glyph, proportional);
+    }
+}
+
+// Columns the message moves on for the glyph at index.
+uint8_t DisplayClass::GlyphAdvance(uint8_t const index, bool const proportional) {
+    if (!proportional)
+        return 8;
+
+    uint8_t const *const text = &_StringCharArray[_Show][2];
+    return Font.Advance(text[index], index + 1 < _StringLength[_Show] ? text[index + 1] : ' ');
+}
+
+// Show the next _Width columns of the stream, then move it on one column if advance is set.
+// Characters are only drawn as they are about to scroll on.
+void DisplayClass::StreamTick(bool const advance) {
+
+    // Drawn columns are in the old orientation, start again from a blank display.
+    if (_StreamRotation != _Rotation) {
+        _StreamRotation = _Rotation;
+        _StreamPos = 0;
+        _StreamFill = _Width;
+        memset(_StreamBits, 0, sizeof(_StreamBits));
+    }
+
+    while (_StreamFill < _Width && StreamPull());
+
+    // Run out of text, scroll blank columns until there is more.
+    if (_StreamFill < _Width)
+        _StreamFill = _Width;
+
+    uint8_t const panels = _LightGrid.PanelCount();
+
+    for (uint8_t panel = 0; panel < panels; panel++) {
+        // Rotations 1 and 3 turn the chain around, as well as each panel.
+        uint8_t const from = _StreamPos + ((_Rotation & 0x01) ? panels - 1 - panel : panel) * Display_PanelWidth;
+
+        for (uint8_t column = 0; column < 8; column++) {
+            uint16_t const bits = RingWindow(_StreamBits[column], from);
+            _LightGrid.SetColumn(panel, column, (_Rotation & 0x01) ? Reverse12(bits) : bits);
+        }
+    }
+
+    if (advance) {
+        // Blank the column leaving the canvas, the ring comes back round to it.
+        uint8_t const index = (_StreamPos >> 3) % Display_StreamBitBytes;
+        uint8_t const mask = ~(1u << (_StreamPos & 0x07));
+
+        for (uint8_t column = 0; column < 8; column++)
+            _StreamBits[column][index] &= mask;
+
+        _StreamPos = (_StreamPos + 1) % (Display_StreamBitBytes * 8);
+        _StreamFill--;
+    }
+}
+
+// Draw the next character onto the end of the stream. Returns false if there is none.
+bool DisplayClass::StreamPull() {
+    if (_StreamCount == 0 && _StreamSource != NULL) {
+        char text[Display_StreamChunk];
+        StreamAppend(text, _StreamSource(text, sizeof(text)));
+    }
+
+    if (_StreamCount == 0)
+        return false;
+
+    uint8_t const code = _StreamRing[_StreamHead];
+    _StreamHead = (_StreamHead + 1) % Display_StreamSize;
+    _StreamCount--;
+
+    bool const proportional = _Rotation & 0x02;
+    uint8_t width;
+    uint64_t image = OrientGlyph(Font.Image(code, !proportional, &width));
+
+    // Rotations 1 and 3 are drawn back to front, turn them into scroll order.
+    if (_Rotation & 0x01)
+        image = BitMatrix::FlipColumns(image);
+
+    uint8_t const at = (_StreamPos + _StreamFill) % (Display_StreamBitBytes * 8);
+    uint8_t const index = at >> 3;
+
+    for (uint8_t column = 0; column < 8; column++) {
+        uint16_t const bits = (uint16_t)(uint8_t)(image >> (column * 8)) << (at & 0x07);
+        _StreamBits[column][index] |= (uint8_t)bits;
+        _StreamBits[column][(index + 1) % Display_StreamBitBytes] |= (uint8_t)(bits >> 8);
+    }
+
+    _StreamFill += proportional ? Font.Advance(code, _StreamCount ? _StreamRing[_StreamHead] : ' ') : 8;
+    return true;
+}
+
 // Each image is 64 bits of data.
 // uint64_t Image = 0x0123456789ABCDEF;
 // 0x01 = Bottom row of image. 1 is the left most LED's, 0 is the right most LED's.
@@ -299,76 +726,16 @@ void DisplayClass::TempShowTimeout() {
 // 55554444
 // 33332222
 // 11110000
-
-// void SetSingleImage64_NoRotation(uint64_t const image64, uint8_t const leftShift)
-// {
-// 	for (uint8_t imageRow = 0; imageRow < 8; imageRow++)
-// 	{
-// 		uint8_t rowData = image64 >> (imageRow*8);
-// 		rowData = ReverseU8[rowData];
-// 		LightGrid.SetColumn(7-imageRow, (uint16_t)rowData << leftShift);
-// 	}
-// }
-
-// Display an image like this
-//             |------------|					leftShift
-//     00000000|AAAAAAAABBBB|BBBBCCCCCCCC		0
-//     0000000A|AAAAAAABBBBB|BBBCCCCCCCC0		1
-//           AA|AAAAAABBBBBB|BBCCCCCCCC			2
-//          AAA|AAAAABBBBBBB|BCCCCCCCC			3
-//         AAAA|AAAABBBBBBBB|CCCCCCCC			4
-//        AAAAA|AAABBBBBBBBC|CCCCCCC			5
-//       AAAAAA|AABBBBBBBBCC|CCCCCC				6
-//      AAAAAAA|ABBBBBBBBCCC|CCCCC				7
-//     AAAAAAAA|BBBBBBBBCCCC|CCCC				Same as 0!
-void DisplayClass::SetTrippleImage64(uint64_t const aa64, uint64_t const bb64, uint64_t const cc64, uint8_t leftShift) {
-    uint8_t rowArray[24];
-
-    if (leftShift > 12)
-        leftShift = 12;
-    
-    for (uint8_t imageRow = 0; imageRow < 8; imageRow++) {
-        uint8_t rowDataA = aa64 >> (imageRow*8);
-        uint8_t rowDataB = bb64 >> (imageRow*8);
-        uint8_t rowDataC = cc64 >> (imageRow*8);
-
-        // Upside down?
-        if (_Rotation == 0x03 || _Rotation == 0x00)	{
-            rowDataA = ReverseU8[rowDataA];
-            rowDataB = ReverseU8[rowDataB];
-            rowDataC = ReverseU8[rowDataC];
-        }
-        
-        // Display Landscape Mode = 12 Wide by 8 Tall Pixels
-        if (_Rotation & 0x02) {
-            uint32_t rowData32;
-            
-            if (_Rotation & 0x01) {				
-                rowData32 = ((((uint32_t)rowDataA) << 16) & 0x00FF0000) | ((((uint32_t)rowDataB) << 8) & 0x0000FF00) | ((((uint32_t)rowDataC) << 0) & 0x000000FF);
-                _LightGrid.SetColumn(7-imageRow, (uint16_t)(rowData32 >> (12 - leftShift)));
-            } else {
-                rowData32 = ((((uint32_t)rowDataC) << 16) & 0x00FF0000) | ((((uint32_t)rowDataB) << 8) & 0x0000FF00) | ((((uint32_t)rowDataA) << 0) & 0x000000FF);
-                _LightGrid.SetColumn(imageRow, (uint16_t)(rowData32 >> (leftShift)));
-            }	
-        }
-
-        // Display Portrait Mode = 8 Wide by 12 Tall Pixels
-        else {
-            rowArray[23-imageRow] = rowDataA;
-            rowArray[15-imageRow] = rowDataB;
-            rowArray[7-imageRow] = rowDataC;
-        }
-    }
-
-    // Display Portrait Mode = 8 Wide by 12 Tall Pixels
-    if (_Rotation < 0x02) {
-        for (uint8_t displayRow = 0; displayRow < 12; displayRow++)	{
-            if (_Rotation & 0x01) {
-                _LightGrid.SetRow(displayRow, rowArray[displayRow + 12 - leftShift]);
-            } else {
-                _LightGrid.SetRow(11-displayRow, rowArray[displayRow + 12 - leftShift]);
-            }
-        }		
+//
+// Turn an image into 8 strip bytes, byte n is the slice for display column n.
+// Display Landscape Mode = 12 Wide by 8 Tall Pixels, each image row is a display column.
+// Display Portrait Mode = 8 Wide by 12 Tall Pixels, each image column is a display column.
+uint64_t DisplayClass::OrientGlyph(uint64_t const image) {
+    switch (_Rotation) {
+        case 0x00:  return BitMatrix::Rotate270(image);     // Upside down portrait
+        case 0x01:  return BitMatrix::Rotate90(image);      // Portrait
+        case 0x02:  return image;                           // Landscape
+        default:    return BitMatrix::Rotate180(image);     // Upside down landscape
     }
 }
 
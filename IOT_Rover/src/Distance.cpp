@@ -1,42 +1,129 @@
 #include "Distance.h"
+#include "I2CBus.h"
 
 Distance::Distance():
+    _continuous(false),
+    _rangePending(false),
+    _rangeStartUs(0),
+    _emptyPollUs(0),
+    _readingUs(0),
     _proximityThreshold(DEFAULT_THRESHOLD),
     _hysteresis(DEFAULT_HYSTERESIS),
+    _isWithinThreshold(false),
     _isWithinRange(false)
 {
 
 }
 
+// The high speed mode, about 20ms a ranging. The sensor sleeps between
+// rangings until SetContinuous() has it range back to back.
 uint8_t Distance::Init()
 {
-    return begin();
+    if (!begin())
+    {
+        return false;
+    }
+    return configSensor(VL53L0X_SENSE_HIGH_SPEED);
+}
+
+// Range back to back, so that a reading is never more than one ranging old,
+// or one ranging each Poll() with the sensor asleep in between.
+void Distance::SetContinuous(bool continuous)
+{
+    if (continuous == _continuous)
+    {
+        return;
+    }
+    I2CBus.Flush(I2CBus_PriorityTof);
+    uint32_t startUs = micros();
+    if (continuous)
+    {
+        _continuous = startRangeContinuous(0);
+        _rangeStartUs = startUs;
+        _emptyPollUs = startUs;
+    }
+    else
+    {
+        stopRangeContinuous();
+        _continuous = false;
+    }
+    _rangePending = _continuous;
+    I2CBus.Account(TOF_I2C_ADDRESS, micros() - startUs, true);
 }
 
+// The last reading, Poll() takes a new one when it is ready.
 uint16_t Distance::GetDistance()
 {
-    update();
     return _distance;
 }
 
 bool Distance::IsWithinThreshold()
 {
-    update();
     return _isWithinThreshold;
 }
 
 bool Distance::IsWithinRange()
 {
-    update();
     return _isWithinRange;
 }
 
-void Distance::update()
+void Distance::SetThreshold(uint16_t threshold, uint8_t hysteresis)
+{
+    _proximityThreshold = threshold;
+    _hysteresis = hysteresis < threshold ? hysteresis : threshold;
+}
+
+// Check for a finished ranging, without waiting for one. Out of continuous
+// ranging, start the next one. ReadingUs() is when the new reading's ranging
+// began.
+// Returns true if there is a new reading.
+bool Distance::Poll()
+{
+    // The VL53L0X library drives Wire itself, let the queued motor traffic go first.
+    I2CBus.Flush(I2CBus_PriorityTof);
+    uint32_t startUs = micros();
+    bool complete = _rangePending && isRangeComplete();
+    uint16_t range = complete ? readRangeResult() : 0;
+    if (complete && _continuous)
+    {
+        // It was ready after the last empty poll, and no sooner than one
+        // ranging after this one began. Take the earliest it could have
+        // been, the worst case for the latency.
+        uint32_t readyUs = _rangeStartUs + TOF_TIMING_BUDGET_US;
+        if ((int32_t)(_emptyPollUs - readyUs) > 0)
+        {
+            readyUs = _emptyPollUs;
+        }
+        _readingUs = readyUs - TOF_TIMING_BUDGET_US;
+        _rangeStartUs = readyUs;
+    }
+    else if (complete)
+    {
+        _readingUs = _rangeStartUs;
+    }
+    if (_continuous)
+    {
+        _emptyPollUs = startUs;
+    }
+    else if (complete || !_rangePending)
+    {
+        _rangePending = startRange();
+        _rangeStartUs = micros();
+    }
+    I2CBus.Account(TOF_I2C_ADDRESS, micros() - startUs, true);
+    if (complete)
+    {
+        update(range);
+    }
+    return complete;
+}
+
+void Distance::update(uint16_t range)
 {
-    rangingTest(&_measure, false);
-    if (_measure.RangeStatus != 4)
+    // 0xFFFF is out of range, or a failed read.
+    if (range != 0xFFFF)
     {
-        _distance = _measure.RangeMilliMeter;
+        _distance = range;
         _isWithinRange = true;
     } else
     {
@@ -51,5 +138,6 @@ void Distance::update()
     {
         threshold = _proximityThreshold - _hysteresis;
     }
-    _isWithinThreshold = (_distance < threshold);
+    // Nothing in range is a clear path, not the last distance seen.
+    _isWithinThreshold = _isWithinRange && (_distance < threshold);
 }
@@ -0,0 +1,286 @@
+//////////////////////////////// DriveScript.cpp //////////////////////////////
+// Filename:	DriveScript.cpp
+// Description: Run a timed list of moves on the rover, without the app.
+// Author:		Danon Bradford
+// Date:		2020-05-16
+//////////////////////////////// DriveScript.cpp //////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include <Blynk/BlynkTimer.h>
+#include "Display.h"				// Display Header file
+#include "Format.h"					// Format Header file
+#include "Mobility.h"				// Mobility Header file
+#include "DriveScript.h"			// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+DriveScriptClass DriveScript;
+
+//*****************************************************************************
+// Externally Defined Global Variables
+//-----------------------------------------------------------------------------
+extern BlynkTimer GlobalTimer;
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// Bytes in each step, by op code. Text also has its characters.
+static const uint8_t StepSize[] = {1, 3, 1, 3, 2, 2, 1};
+
+static const char *const StateName[] = {
+    "idle", "running", "finished", "cancelled", "overridden", "stopped by an obstacle", "stopped, no wait"
+};
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+uint8_t DriveScriptClass::_Code[DriveScript_MaxBytes];
+uint8_t DriveScriptClass::_Length = 0;
+uint8_t DriveScriptClass::_Pc = 0;
+DriveScript_Loop_t DriveScriptClass::_Loops[DriveScript_MaxDepth];
+uint8_t DriveScriptClass::_Depth = 0;
+uint8_t DriveScriptClass::_State = DriveScript_Idle;
+int DriveScriptClass::_TID = -1;
+
+// When the script started, when the next step is due, and the latest a step has run.
+uint32_t DriveScriptClass::_StartMs = 0;
+uint32_t DriveScriptClass::_DueMs = 0;
+uint32_t DriveScriptClass::_LateMaxMs = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+
+//=============================================================================
+// DriveScript::Load
+//
+// Replace the script from one line of hex, two digits a byte. Spaces and
+// commas between bytes are skipped.
+// Input:
+//	  text - The script.
+// Output:
+//	  bool - false if the script is not valid, the old script is kept.
+//-----------------------------------------------------------------------------
+bool DriveScriptClass::Load(const char *text) {
+    uint8_t code[DriveScript_MaxBytes];
+    uint8_t length = 0;
+
+    if (text == NULL)
+        return false;
+
+    while (*text) {
+        if (*text == ' ' || *text == ',') {
+            text++;
+            continue;
+        }
+
+        uint64_t value;
+        if (length >= DriveScript_MaxBytes || !Format.ParseHex(text, 2, &value))
+            return false;
+
+        code[length++] = value;
+        text += 2;
+    }
+
+    if (!Check(code, length))
+        return false;
+
+    Stop();
+    memcpy(_Code, code, length);
+    _Length = length;
+    return true;
+}
+
+// Run from the first step.
+void DriveScriptClass::Start() {
+    Stop();
+
+    if (_Length == 0)
+        return;
+
+    _Pc = 0;
+    _Depth = 0;
+    _State = DriveScript_Running;
+    _StartMs = millis();
+    _DueMs = _StartMs;
+    _LateMaxMs = 0;
+
+    Mobility.SubscribeOverride(Overridden);
+    Run();
+}
+
+void DriveScriptClass::Stop() {
+    if (IsRunning())
+        End(DriveScript_Cancelled);
+}
+
+void DriveScriptClass::PrintStats() {
+    Serial.printf("Drive script: %u bytes, %s, up to %u ms late\n",
+                  _Length, StateName[_State], _LateMaxMs);
+}
+
+// private:
+// Every step is whole and known, the drive values are in range and the loops pair up.
+bool DriveScriptClass::Check(uint8_t const *const code, uint8_t const length) {
+    uint8_t pc = 0;
+    uint8_t depth = 0;
+
+    while (pc < length) {
+        uint8_t const op = code[pc];
+
+        if (op >= sizeof(StepSize) || pc + StepSize[op] > length)
+            return false;
+
+        switch (op) {
+            case DriveScript_Drive:
+                if ((int8_t)code[pc + 1] < -Mobility_InputMax || (int8_t)code[pc + 1] > Mobility_InputMax ||
+                    (int8_t)code[pc + 2] < -Mobility_InputMax || (int8_t)code[pc + 2] > Mobility_InputMax)
+                    return false;
+                break;
+
+            case DriveScript_Wait:
+                if (code[pc + 1] == 0 && code[pc + 2] == 0)
+                    return false;
+                break;
+
+            case DriveScript_Text:
+                if (code[pc + 1] == 0 || code[pc + 1] > DriveScript_MaxText || pc + 2 + code[pc + 1] > length)
+                    return false;
+                pc += code[pc + 1];
+                break;
+
+            case DriveScript_Loop:
+                if (++depth > DriveScript_MaxDepth)
+                    return false;
+                break;
+
+            case DriveScript_Next:
+                if (depth-- == 0)
+                    return false;
+                break;
+        }
+
+        pc += StepSize[op];
+    }
+
+    return length > 0 && depth == 0;
+}
+
+// Stop the timer and leave the motors to suit how the script ended.
+void DriveScriptClass::End(uint8_t const state) {
+    if (_TID != -1) {
+        GlobalTimer.deleteTimer(_TID);
+        _TID = -1;
+    }
+
+    _State = state;
+
+    // A manual command has its own setpoint. After an obstacle the rover stays
+    // braked, so that it does not drive on by itself once the way is clear.
+    if (state == DriveScript_Obstacle)
+        Mobility.ScriptBrake();
+    else if (state != DriveScript_Overridden && !Mobility.IsStopped())
+        Mobility.ScriptDrive(0, 0);
+
+    Serial.printf("Drive script %s after %lu ms\n", StateName[state], (unsigned long)(millis() - _StartMs));
+}
+
+//=============================================================================
+// DriveScript::Run
+//
+// Run steps from the program counter up to the next wait that is not due yet,
+// then set the timer for it.
+//-----------------------------------------------------------------------------
+void DriveScriptClass::Run() {
+    _TID = -1;
+
+    uint32_t const lateMs = millis() - _DueMs;
+    if (lateMs > _LateMaxMs)
+        _LateMaxMs = lateMs;
+
+    for (uint8_t steps = 0; steps < DriveScript_StepBudget; steps++) {
+        if (_Pc >= _Length) {
+            End(DriveScript_Finished);
+            return;
+        }
+
+        uint8_t const *const step = &_Code[_Pc];
+
+        switch (step[0]) {
+            case DriveScript_Drive:
+                if ((int8_t)step[1] > 0 && Mobility.IsBlocked()) {
+                    End(DriveScript_Obstacle);
+                    return;
+                }
+                Mobility.ScriptDrive(step[1], step[2]);
+                break;
+
+            case DriveScript_Brake:
+                Mobility.ScriptBrake();
+                break;
+
+            case DriveScript_Wait: {
+                _DueMs += ((uint16_t)step[1] << 8) | step[2];
+                _Pc += StepSize[DriveScript_Wait];
+
+                // Behind time, run on to catch up.
+                int32_t const waitMs = _DueMs - millis();
+                if (waitMs > 0) {
+                    _TID = GlobalTimer.setTimeout(waitMs, Run);
+                    return;
+                }
+                continue;
+            }
+
+            case DriveScript_Text: {
+                char text[DriveScript_MaxText + 1];
+                memcpy(text, &step[2], step[1]);
+                text[step[1]] = 0;
+                _Pc += step[1];
+
+                Display.SetString(Display_TEMPORARY_Show, text);
+                Display.SetMode(Display_TEMPORARY_Show, Display_String_Mode);
+                Display.ActivateTempShow(DriveScript_TextMs);
+                break;
+            }
+
+            case DriveScript_Loop:
+                _Loops[_Depth].Start = _Pc + StepSize[DriveScript_Loop];
+                _Loops[_Depth].Remaining = step[1];
+                _Depth++;
+                break;
+
+            case DriveScript_Next: {
+                DriveScript_Loop_t *const loop = &_Loops[_Depth - 1];
+
+                if (loop->Remaining == 0 || --loop->Remaining > 0) {
+                    _Pc = loop->Start;
+                    continue;
+                }
+                _Depth--;
+                break;
+            }
+
+            default:
+                End(DriveScript_Finished);
+                return;
+        }
+
+        _Pc += StepSize[step[0]];
+    }
+
+    End(DriveScript_Runaway);
+}
+
+// A manual command or the obstacle reflex, the script gives way.
+void DriveScriptClass::Overridden(Mobility_Override const reason) {
+    if (IsRunning())
+        End(reason == Mobility_ObstacleOverride ? DriveScript_Obstacle : DriveScript_Overridden);
+}
+
+// DriveScript.cpp EOF
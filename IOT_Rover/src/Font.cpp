@@ -0,0 +1,172 @@
+//////////////////////////////// Font.cpp /////////////////////////////////////
+// Filename:	Font.cpp
+// Description: Proportional width font for the IDL display.
+// Author:		Danon Bradford
+// Date:		2020-04-04
+//////////////////////////////// Font.cpp /////////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include "BitMatrix.h"				// Bit Matrix Header file
+#include "FontData.h"				// Font tables
+#include "Font.h"					// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+FontClass Font;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+uint32_t FontClass::CacheHits = 0;
+uint32_t FontClass::CacheMisses = 0;
+
+// Most recently used first.
+Font_Cached_t FontClass::_Cache[Font_CacheSize];
+uint8_t FontClass::_CacheCount = 0;
+
+// CPU cycles spent finding glyphs, to show what the flash reads cost.
+uint32_t FontClass::_HitCycles = 0;
+uint32_t FontClass::_MissCycles = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+
+//=============================================================================
+// Font::Image
+//
+// Rebuild an 8x8 image of a glyph, in the U64 image layout.
+// Input:
+//	  code    - The character.
+//    bearing - true to keep the glyph where it sat in the 8x8 cell, false to
+//              move it against column 0.
+//    width   - Set to the number of columns used, 0 for a blank glyph.
+// Output:
+//	  uint64_t - The image.
+//-----------------------------------------------------------------------------
+uint64_t FontClass::Image(uint8_t const code, bool const bearing, uint8_t *const width) {
+    Font_Cached_t const *const glyph = Lookup(code);
+
+    // The columns were stored as rows, turn them back into the image rows.
+    uint64_t const image = BitMatrix::Transpose(glyph->Columns);
+
+    *width = glyph->Width;
+    return bearing ? image << glyph->Left : image;
+}
+
+// Columns to move on after a character when text is scrolled sideways.
+// With kerning, the next glyph moves one column closer if their facing
+// edges do not touch, on the same or neighbouring rows.
+uint8_t FontClass::Advance(uint8_t const code, uint8_t const next) {
+    Font_Cached_t const *const glyph = Lookup(code);
+
+    if (glyph->Width == 0)
+        return Font_SpaceAdvance;
+
+    uint8_t const width = glyph->Width;
+
+#if Font_Kerning
+    uint8_t const edge = glyph->Columns >> ((width - 1) * 8);
+    Font_Cached_t const *const nextGlyph = Lookup(next);
+
+    if (nextGlyph->Width != 0) {
+        uint8_t const nextEdge = nextGlyph->Columns;
+
+        if (!(edge & (nextEdge | (uint8_t)(nextEdge << 1) | (nextEdge >> 1))))
+            return width + Font_Spacing - 1;
+    }
+#else
+    (void)next;
+#endif
+
+    return width + Font_Spacing;
+}
+
+void FontClass::PrintStats() {
+    uint32_t const flashBytes = sizeof(FontColumns) + sizeof(FontGlyphs) + sizeof(FontRanges);
+
+    Serial.printf("Font: %u bytes in flash, %u bytes of cache in RAM\n", flashBytes, (unsigned)sizeof(_Cache));
+    Serial.printf("Font cache: %u hits at %u cycles, %u misses at %u cycles\n",
+                  CacheHits, CacheHits ? _HitCycles / CacheHits : 0,
+                  CacheMisses, CacheMisses ? _MissCycles / CacheMisses : 0);
+}
+
+// private:
+// Find a glyph in the cache, loading it from flash if it is not there.
+// The entry found is moved to the front, so the last entry is the least recently used.
+Font_Cached_t const* FontClass::Lookup(uint8_t const code) {
+    uint32_t const startCycles = ESP.getCycleCount();
+    uint8_t index = 0;
+
+    while (index < _CacheCount && _Cache[index].Code != code)
+        index++;
+
+    bool const hit = index < _CacheCount;
+
+    if (!hit) {
+        if (_CacheCount < Font_CacheSize)
+            _CacheCount++;
+        index = _CacheCount - 1;
+    }
+
+    Font_Cached_t entry = _Cache[index];
+
+    if (!hit)
+        Load(code, &entry);
+
+    memmove(&_Cache[1], &_Cache[0], index * sizeof(_Cache[0]));
+    _Cache[0] = entry;
+
+    if (hit) {
+        CacheHits++;
+        _HitCycles += ESP.getCycleCount() - startCycles;
+    } else {
+        CacheMisses++;
+        _MissCycles += ESP.getCycleCount() - startCycles;
+    }
+
+    return &_Cache[0];
+}
+
+// Read a glyph out of the flash tables. Flash is only read as aligned 32 bit words.
+void FontClass::Load(uint8_t const code, Font_Cached_t *const entry) {
+    entry->Code = code;
+    entry->Columns = 0;
+    entry->Width = 0;
+    entry->Left = 0;
+
+    for (uint8_t i = 0; i < Font_RangeCount; i++) {
+        uint32_t const range = pgm_read_dword(&FontRanges[i]);
+        uint8_t const first = range;
+        uint8_t const count = range >> 8;
+
+        if (code < first || code - first >= count)
+            continue;
+
+        uint32_t const glyph = pgm_read_dword(&FontGlyphs[(uint8_t)(range >> 16) + code - first]);
+        uint16_t const offset = glyph;
+        uint8_t const width = (glyph >> 16) & 0x0F;
+
+        // The three words that cover the columns, FontColumns is padded for this.
+        uint32_t const *const words = (uint32_t const*)&FontColumns[offset & ~0x03u];
+        uint64_t const low = pgm_read_dword(&words[0]) | ((uint64_t)pgm_read_dword(&words[1]) << 32);
+        uint32_t const high = pgm_read_dword(&words[2]);
+        uint8_t const shift = (offset & 0x03) * 8;
+
+        uint64_t columns = shift ? (low >> shift) | ((uint64_t)high << (64 - shift)) : low;
+        if (width < 8)
+            columns &= ((uint64_t)1 << (width * 8)) - 1;
+
+        entry->Columns = columns;
+        entry->Width = width;
+        entry->Left = (glyph >> 20) & 0x0F;
+        return;
+    }
+}
+
+// Font.cpp EOF
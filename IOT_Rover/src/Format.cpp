@@ -0,0 +1,162 @@
+//////////////////////////////// Format.cpp ///////////////////////////////////
+// Filename:	Format.cpp
+// Description: Number to text and text to number, into fixed buffers.
+// Author:		Danon Bradford
+// Date:		2020-04-18
+//////////////////////////////// Format.cpp ///////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include "Format.h"					// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+FormatClass Format;
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static const uint16_t DecimalScale[] = {1, 10, 100, 1000};
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+
+// Append a string.
+uint8_t FormatClass::Text(char *const buffer, uint8_t const size, uint8_t length, const char *text) {
+    while (*text && length + 1 < size)
+        buffer[length++] = *text++;
+
+    buffer[length] = 0;
+    return length;
+}
+
+// Append a number in decimal.
+uint8_t FormatClass::Unsigned(char *const buffer, uint8_t const size, uint8_t const length, uint32_t value) {
+    char digits[Format_NumberSize];
+    uint8_t count = 0;
+
+    // The digits come out lowest first, put them in the other way around.
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    char *next = &digits[count];
+    uint8_t newLength = length;
+    while (next != digits && newLength + 1 < size)
+        buffer[newLength++] = *--next;
+
+    buffer[newLength] = 0;
+    return newLength;
+}
+
+// Append a signed number in decimal.
+uint8_t FormatClass::Int(char *const buffer, uint8_t const size, uint8_t length, int32_t const value) {
+    if (value < 0)
+        length = Text(buffer, size, length, "-");
+
+    // Done unsigned, so that INT32_MIN does not overflow.
+    return Unsigned(buffer, size, length, value < 0 ? 0u - (uint32_t)value : (uint32_t)value);
+}
+
+//=============================================================================
+// Format::Fixed
+//
+// Append a number rounded to a number of decimal places, the same text as
+// String(value, decimals) gives without going through the heap.
+// Input:
+//	  value    - The number, it is limited to about +/- 2 million.
+//    decimals - Digits after the decimal point, 0 to 3.
+// Output:
+//	  uint8_t - The new length.
+//-----------------------------------------------------------------------------
+uint8_t FormatClass::Fixed(char *const buffer, uint8_t const size, uint8_t length, float const value, uint8_t const decimals) {
+    uint8_t const places = decimals > 3 ? 3 : decimals;
+    uint16_t const scale = DecimalScale[places];
+
+    // Round once, in whole units of the last decimal place.
+    float const scaled = value * scale;
+    int32_t const units = scaled > 2e9f ? 2000000000 : (scaled < -2e9f ? -2000000000 : (int32_t)lroundf(scaled));
+    uint32_t const magnitude = units < 0 ? -units : units;
+
+    if (units < 0)
+        length = Text(buffer, size, length, "-");
+
+    length = Unsigned(buffer, size, length, magnitude / scale);
+
+    if (places) {
+        length = Text(buffer, size, length, ".");
+
+        // Leading zeros of the fraction, 0.05 is "0" "." "0" "5".
+        uint16_t const fraction = magnitude % scale;
+        for (uint16_t limit = scale / 10; limit > 1 && fraction < limit; limit /= 10)
+            length = Text(buffer, size, length, "0");
+
+        length = Unsigned(buffer, size, length, fraction);
+    }
+
+    return length;
+}
+
+// Append a number in lower case hex, at least digits long with leading zeros.
+uint8_t FormatClass::Hex(char *const buffer, uint8_t const size, uint8_t const length, uint32_t value, uint8_t const digits) {
+    char text[9];
+    uint8_t count = 0;
+
+    do {
+        uint8_t const nibble = value & 0x0F;
+        text[count++] = nibble < 10 ? '0' + nibble : 'a' + nibble - 10;
+        value >>= 4;
+    } while ((value || count < digits) && count < 8);
+
+    char *next = &text[count];
+    uint8_t newLength = length;
+    while (next != text && newLength + 1 < size)
+        buffer[newLength++] = *--next;
+
+    buffer[newLength] = 0;
+    return newLength;
+}
+
+// The value of a hex digit, -1 if c is not one.
+int8_t FormatClass::HexDigit(char const c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+//=============================================================================
+// Format::ParseHex
+//
+// Read a fixed number of hex digits straight out of a longer string, so that
+// no substring has to be made first.
+// Input:
+//	  text   - The first digit.
+//    digits - How many digits to read, up to 16.
+//    value  - Set to the number read. Like strtoull, a bad character ends the
+//             number and value keeps the digits before it.
+// Output:
+//	  bool - false if a bad character or the end of the text came first.
+//-----------------------------------------------------------------------------
+bool FormatClass::ParseHex(const char *text, uint8_t const digits, uint64_t *const value) {
+    *value = 0;
+
+    for (uint8_t i = 0; i < digits; i++) {
+        int8_t const nibble = HexDigit(text[i]);
+
+        if (nibble < 0)
+            return false;
+
+        *value = (*value << 4) | (uint8_t)nibble;
+    }
+
+    return true;
+}
+
+// Format.cpp EOF
@@ -0,0 +1,279 @@
+//////////////////////////////// I2CBus.cpp ///////////////////////////////////
+// Filename:	I2CBus.cpp
+// Description: Prioritised transaction queue for the shared I2C bus.
+// Author:		Danon Bradford
+// Date:		2020-03-14
+//////////////////////////////// I2CBus.cpp ///////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include <Wire.h>					// I2C Header file
+#include "I2CBus.h"					// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+I2CBusClass I2CBus;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+uint32_t I2CBusClass::Dropped = 0;
+uint32_t I2CBusClass::ClockHz = I2CBus_Standard;
+
+// One ring of descriptor pointers per priority level.
+I2CBus_Trans_t* I2CBusClass::_Queue[I2CBus_PriorityCount][I2CBus_QueueDepth];
+uint8_t I2CBusClass::_QueueHead[I2CBus_PriorityCount] = {0};
+uint8_t I2CBusClass::_QueueCount[I2CBus_PriorityCount] = {0};
+
+// Per device counters, a slot is taken by the first transaction to an address.
+I2CBus_Stats_t I2CBusClass::_Stats[I2CBus_StatsCount] = {{0}};
+
+// Bus busy time over the current profile window, and the result of the last one.
+uint32_t I2CBusClass::_WindowStartMs = 0;
+uint32_t I2CBusClass::_WindowBusyUs = 0;
+uint16_t I2CBusClass::_DutyPermille = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+
+//=============================================================================
+// I2CBus::Begin
+//
+// Set the bus clock. Fast mode is only kept if every device that answers at
+// the standard clock still answers at 400kHz.
+// Input:
+//	  fastMode - true to try the 400kHz clock.
+//    addrs    - The attached device addresses to check.
+//    count    - The number of addresses, up to I2CBus_StatsCount.
+// Output:
+//	  bool     - true if the bus runs at the requested clock.
+// Conditions:
+//    Wire.begin() has been called.
+//-----------------------------------------------------------------------------
+bool I2CBusClass::Begin(bool const fastMode, uint8_t const *const addrs, uint8_t const count) {
+    ClockHz = I2CBus_Standard;
+    Wire.setClock(ClockHz);
+
+    if (!fastMode)
+        return true;
+
+    uint16_t present = 0x0000u;
+
+    for (uint8_t i = 0; i < count && i < I2CBus_StatsCount; i++) {
+        if (Probe(addrs[i])) present |= 0x01u << i;
+    }
+
+    ClockHz = I2CBus_Fast;
+    Wire.setClock(ClockHz);
+
+    for (uint8_t i = 0; i < count && i < I2CBus_StatsCount; i++) {
+        if ((present & (0x01u << i)) && !Probe(addrs[i])) {
+            Serial.printf("I2C 0x%02X lost at %u Hz, staying at %u Hz\n", addrs[i], I2CBus_Fast, I2CBus_Standard);
+            ClockHz = I2CBus_Standard;
+            Wire.setClock(ClockHz);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void I2CBusClass::Init(I2CBus_Trans_t *const trans, uint8_t const addr,
+                       I2CBus_Type const type, I2CBus_Priority const priority) {
+    memset(trans, 0, sizeof(*trans));
+    trans->Addr = addr;
+    trans->Type = type;
+    trans->Priority = priority;
+    trans->Status = I2CBus_Idle;
+}
+
+// Queue a transaction to run from Run(). Returns false if the queue is full.
+bool I2CBusClass::Submit(I2CBus_Trans_t *const trans) {
+    // Already waiting in the queue, it will be sent with its latest contents.
+    if (trans->Status == I2CBus_Pending)
+        return true;
+
+    uint8_t const prio = trans->Priority < I2CBus_PriorityCount ? trans->Priority : I2CBus_PriorityCount - 1;
+
+    if (_QueueCount[prio] >= I2CBus_QueueDepth) {
+        Dropped++;
+        return false;
+    }
+
+    trans->Status = I2CBus_Pending;
+    _Queue[prio][(_QueueHead[prio] + _QueueCount[prio]) % I2CBus_QueueDepth] = trans;
+    _QueueCount[prio]++;
+    return true;
+}
+
+// Run a transaction now. Anything queued with a more urgent priority goes first.
+bool I2CBusClass::Transact(I2CBus_Trans_t *const trans) {
+    Flush(trans->Priority);
+    Complete(trans);
+    return trans->Status == I2CBus_Ok;
+}
+
+// Run every queued transaction that is more urgent than the given priority.
+// External drivers that use Wire directly call this before they take the bus.
+void I2CBusClass::Flush(uint8_t const priority) {
+    for (uint8_t prio = 0; prio < priority && prio < I2CBus_PriorityCount; prio++) {
+        while (_QueueCount[prio]) {
+            I2CBus_Trans_t *const trans = _Queue[prio][_QueueHead[prio]];
+            _QueueHead[prio] = (_QueueHead[prio] + 1) % I2CBus_QueueDepth;
+            _QueueCount[prio]--;
+            Complete(trans);
+        }
+    }
+}
+
+void I2CBusClass::Run() {
+    Flush(I2CBus_PriorityCount);
+}
+
+// An address only write, true if the device acknowledged.
+bool I2CBusClass::Probe(uint8_t const addr) {
+    I2CBus_Trans_t trans;
+    Init(&trans, addr, I2CBus_Write, I2CBus_PriorityMotor);
+    return Transact(&trans);
+}
+
+// Record bus time used by a driver that drives Wire itself.
+void I2CBusClass::Account(uint8_t const addr, uint32_t const busyUs, bool const ok) {
+    I2CBus_Trans_t trans;
+    Init(&trans, addr, I2CBus_Write, I2CBus_PriorityTof);
+    trans.Status = ok ? I2CBus_Ok : I2CBus_BusError;
+    Record(&trans, busyUs);
+}
+
+// Percentage of the last profile window the bus was busy, in tenths.
+uint16_t I2CBusClass::DutyPermille() {
+    RollWindow(millis());
+    return _DutyPermille;
+}
+
+uint8_t I2CBusClass::Pending() {
+    uint8_t count = 0;
+
+    for (uint8_t prio = 0; prio < I2CBus_PriorityCount; prio++)
+        count += _QueueCount[prio];
+
+    return count;
+}
+
+// Transactions that can still be queued at a priority.
+uint8_t I2CBusClass::Room(uint8_t const priority) {
+    uint8_t const prio = priority < I2CBus_PriorityCount ? priority : I2CBus_PriorityCount - 1;
+    return I2CBus_QueueDepth - _QueueCount[prio];
+}
+
+const I2CBus_Stats_t* I2CBusClass::GetStats(uint8_t const index) {
+    if (index >= I2CBus_StatsCount || _Stats[index].Addr == 0)
+        return NULL;
+
+    return &_Stats[index];
+}
+
+void I2CBusClass::PrintStats() {
+    uint16_t const duty = DutyPermille();
+
+    Serial.printf("I2C %u Hz, duty %u.%u%%, dropped %u\n", ClockHz,
+                  duty / 10, duty % 10, Dropped);
+
+    for (uint8_t i = 0; i < I2CBus_StatsCount && _Stats[i].Addr; i++) {
+        Serial.printf("I2C 0x%02X: %u transactions, %u bytes, %u errors, %u nacks, %u us\n", _Stats[i].Addr,
+                      _Stats[i].Transactions, _Stats[i].Bytes, _Stats[i].Errors, _Stats[i].Nacks, _Stats[i].BusyUs);
+    }
+}
+
+// private:
+void I2CBusClass::Complete(I2CBus_Trans_t *const trans) {
+    uint32_t const startUs = micros();
+    trans->Status = Execute(trans);
+    Record(trans, micros() - startUs);
+
+    if (trans->Callback)
+        trans->Callback(trans);
+}
+
+// The one place the I2C bus is driven.
+uint8_t I2CBusClass::Execute(I2CBus_Trans_t *const trans) {
+    uint8_t const txLen = trans->TxLen < I2CBus_TxInlineMax ? trans->TxLen : I2CBus_TxInlineMax;
+    size_t written = 0;
+
+    Wire.beginTransmission(trans->Addr);
+    written += Wire.write(trans->TxData, txLen);
+
+    if (trans->Type == I2CBus_Burst && trans->BurstPtr)
+        written += Wire.write(trans->BurstPtr, trans->BurstLen);
+
+    // A write-read keeps the bus with a repeated start.
+    uint8_t status = Wire.endTransmission(trans->Type != I2CBus_WriteRead);
+
+    if (status == I2CBus_Ok && written != (size_t)txLen + (trans->Type == I2CBus_Burst ? trans->BurstLen : 0))
+        status = I2CBus_TooLong;
+
+    if (status == I2CBus_Ok && trans->Type == I2CBus_WriteRead) {
+        if (Wire.requestFrom(trans->Addr, trans->RxLen) == trans->RxLen) {
+            for (uint8_t i = 0; i < trans->RxLen; i++) {
+                uint8_t const data = Wire.read();
+                if (trans->RxPtr) trans->RxPtr[i] = data;
+            }
+        } else {
+            status = I2CBus_ReadShort;
+        }
+    }
+
+    return status;
+}
+
+void I2CBusClass::Record(I2CBus_Trans_t const *const trans, uint32_t const busyUs) {
+    RollWindow(millis());
+    _WindowBusyUs += busyUs;
+
+    I2CBus_Stats_t *const stats = FindStats(trans->Addr);
+
+    if (stats == NULL)
+        return;
+
+    stats->Transactions++;
+    stats->Bytes += trans->TxLen;
+    if (trans->Type == I2CBus_Burst) stats->Bytes += trans->BurstLen;
+    if (trans->Type == I2CBus_WriteRead) stats->Bytes += trans->RxLen;
+    if (trans->Status != I2CBus_Ok) stats->Errors++;
+    if (trans->Status == I2CBus_NackAddr || trans->Status == I2CBus_NackData) stats->Nacks++;
+    stats->BusyUs += busyUs;
+}
+
+// Close the profile window once it has run its length, whether or not the bus
+// has been used since. Windows keep to whole lengths from the first, so a
+// report after a quiet spell is of the last window, which was idle.
+void I2CBusClass::RollWindow(uint32_t const nowMs) {
+    uint32_t const elapsedMs = nowMs - _WindowStartMs;
+
+    if (elapsedMs < I2CBus_ProfileWindow)
+        return;
+
+    uint32_t const permille = elapsedMs < 2 * I2CBus_ProfileWindow ? _WindowBusyUs / I2CBus_ProfileWindow : 0;
+    _DutyPermille = permille > 1000 ? 1000 : permille;
+    _WindowStartMs = nowMs - elapsedMs % I2CBus_ProfileWindow;
+    _WindowBusyUs = 0;
+}
+
+I2CBus_Stats_t* I2CBusClass::FindStats(uint8_t const addr) {
+    for (uint8_t i = 0; i < I2CBus_StatsCount; i++) {
+        if (_Stats[i].Addr == 0)
+            _Stats[i].Addr = addr;
+
+        if (_Stats[i].Addr == addr)
+            return &_Stats[i];
+    }
+
+    return NULL;
+}
+
+// I2CBus.cpp EOF
@@ -11,11 +11,19 @@
 #include "IDL_Version.h"
 #include "ErrorCode.h"
 #include "Planque.h"
+#include "I2CBus.h"
 #include "WiFiMgmt.h"
 #include "DeviceConfig.h"
 #include "Display.h"
+#include "Animation.h"
+#include "AutoBright.h"
+#include "Font.h"
+#include "Format.h"
 #include "Sensors.h"
 #include "Mobility.h"
+#include "DriveScript.h"
+#include "UdpDrive.h"
+#include "Odometry.h"
 #include "VirtualPinDefs.h"
 
 //*****************************************************************************
@@ -26,6 +34,13 @@
 #define SwitchB_PIN             0
 #define SwitchB_CHANGE          FALLING
 
+#define MMA8452Q_I2C            0x1C
+
+// Heap watch. Turn on Heap_Debug for a soak test, it logs every Heap_LogSamples samples.
+// #define Heap_Debug              1
+#define Heap_SampleInterval     1000L
+#define Heap_LogSamples         600
+
 //*****************************************************************************
 // Private Global Variables
 //-----------------------------------------------------------------------------
@@ -48,9 +63,23 @@ uint32_t TemporaryTimeout = 3000;
 BlynkTimer GlobalTimer; 
 int PushServerTID = -1;
 
+// Attached I2C devices, they must all still answer before the bus stays in fast mode.
+// The display panels are added in setup(), from the configured chain.
+const uint8_t I2C_Devices[] = {
+    DRV8830_Addr0,      // Motor drivers
+    DRV8830_Addr2,
+    MMA8452Q_I2C,       // Accelerometer
+    TOF_I2C_ADDRESS     // Time of flight distance sensor
+};
+
+// Worst heap seen since boot
+uint32_t HeapLowWater = 0xFFFFFFFF;
+uint32_t HeapSmallestBlock = 0xFFFFFFFF;
+uint8_t HeapWorstFragmentation = 0;
+
 // Push data to the Blynk server configuration
 const uint32_t DefaultPushInterval = 10000;
-const uint8_t ThingsToPush = 11;
+const uint8_t ThingsToPush = 14;
 
 //*****************************************************************************
 // Private Function Declarations
@@ -60,6 +89,8 @@ void SwitchA_Callback(void);
 void SwitchB_Callback(void);
 void Switch_Handler(void);
 void PushDataToBlynkServer(void);
+void HeapSample(void);
+void HeapPrint(void);
 
 //=============================================================================
 // Arduino Function Definitions
@@ -89,16 +120,41 @@ void setup() {
     // Initialise wire. The I2C bus is used for the Display module and Accelerometer / Pedometer.
     Wire.begin();
 
+    // Select the bus clock, checking every attached device still answers in fast mode.
+    // Each configured panel is checked at its address, in chain order.
+    uint8_t devices[LightGrid_MaxPanels + sizeof(I2C_Devices)];
+    uint8_t deviceCount = 0;
+
+    if (DeviceConfig.getDisplay() == DC_Display_HT16K33) {
+        uint32_t const order = DeviceConfig.getPanelOrder();
+
+        for (uint8_t panel = 0; panel < DeviceConfig.getPanels() && panel < LightGrid_MaxPanels; panel++)
+            devices[deviceCount++] = LightGrid_BaseAddress + ((order >> (panel * 4)) & 0x07);
+    }
+    memcpy(&devices[deviceCount], I2C_Devices, sizeof(I2C_Devices));
+    deviceCount += sizeof(I2C_Devices);
+
+    (void)I2CBus.Begin(DeviceConfig.getI2C() == DC_I2C_Fast400k, devices, deviceCount);
+    Serial.printf("I2C clock %u Hz\n", I2CBus.ClockHz);
+
     bool success;
 
     // Initialise the Display module    
     if (DeviceConfig.getDisplay() == DC_Display_HT16K33) {
+        Display.SetPanels(DeviceConfig.getPanels(), DeviceConfig.getPanelOrder());
         success = Display.Init();
         ErrorCode_12SLog(&DeviceConfig.SetupError, !success);
+
+        // Dim the display with the ambient light, read by the analog sensors.
+        if (DeviceConfig.getBright() == DC_Bright_AmbientLight)
+            AutoBright.Enable(true);
     }
 
     // Initialise the sensors
     Sensors.Init(&DeviceConfig.SetupError);
+
+    // Drive the motors from the latest setpoint at a fixed rate.
+    Mobility.Begin();
     
     // Read Switch A and Switch B. Enter Soft AP mode if both are pressed down.
     if (digitalRead(SwitchA_PIN) && !digitalRead(SwitchB_PIN)) {
@@ -114,20 +170,30 @@ void setup() {
     // Periodically push the sensor data to the Blynk server
     PushServerTID = GlobalTimer.setInterval(DefaultPushInterval / ThingsToPush, PushDataToBlynkServer);
 
+    // Keep the worst heap figures, to show if anything is still fragmenting it.
+    HeapSample();
+    (void)GlobalTimer.setInterval(Heap_SampleInterval, HeapSample);
+
     // Connect to known wifi networks!    
     WiFiMgmt.BeginStation();
 
     // Configure connecting to the Blynk server by subscribing to WiFi connection status.
     WiFiMgmt.SubscribeStatus(NotifyBlynk);
+
+    // Take drive commands straight from the local network as well.
+    UdpDrive.Begin();
 }
 
 void loop() {
     GlobalTimer.run();    
     Switch_Handler();
+    I2CBus.Run();
 
     if (WiFiMgmt.StationConnected && DeviceConfig.ValidBlynk) {
         Blynk.run();        
     } 
+
+    UdpDrive.Run();
 }
 
 //=============================================================================
@@ -139,12 +205,14 @@ BLYNK_CONNECTED() {
 
     if (DeviceConfig.getPower() == DC_Power_EverythingAlwaysOn) {   
         Blynk.setProperty(DisplayMode_Vpin, "labels", "Text", "Number", "U64", "Show Sensor", "Joystick", "Joystick (Persistent)", "All LED's On", "All LED's Off", "Display off");
-        Blynk.syncVirtual(DisplayMode_Vpin, Brightness_Vpin, ScrollRate_Vpin, ScrollEnable_Vpin, TempTimeout_Vpin, PushPeriod_Vpin, PushEnable_Vpin, TempOffset_Vpin, HumOffset_Vpin, MobilityFLAddr_Vpin, MobilityFRAddr_Vpin);
+        Blynk.syncVirtual(DisplayMode_Vpin, Brightness_Vpin, ScrollRate_Vpin, ScrollEnable_Vpin, TempTimeout_Vpin, PushPeriod_Vpin, PushEnable_Vpin, TempOffset_Vpin, HumOffset_Vpin, MobilityFLAddr_Vpin, MobilityFRAddr_Vpin, AutoBrightness_Vpin, DisplayIdle_Vpin, MobilityRamp_Vpin, TofBrake_Vpin, OdometryModel_Vpin, Deadman_Vpin);
 
         Blynk.virtualWrite(SwitchA_Vpin, 255*ToggleStateA);
         Blynk.virtualWrite(SwitchB_Vpin, 255*ToggleStateB);
 
-        Blynk.virtualWrite(ChipUID_Vpin, String(ESP.getChipId(),HEX));
+        char chipId[Format_NumberSize];
+        Format.Hex(chipId, sizeof(chipId), 0, ESP.getChipId(), 0);
+        Blynk.virtualWrite(ChipUID_Vpin, chipId);
         Blynk.virtualWrite(WiFiName_Vpin, WiFi.SSID());
         Blynk.virtualWrite(WiFiRSSI_Vpin, WiFi.RSSI());
         Blynk.virtualWrite(LocalIP_Vpin, WiFi.localIP().toString());
@@ -242,17 +310,41 @@ BLYNK_WRITE(DisplayMode_Vpin) {
             Display.SetMode(Display_PRIMARY_Show, Display_DisplayOff_Mode);
             break;
         }
+
+        // Animation Mode
+        case 10:{
+            MenuDisplayMode = 0x09;
+            Display.SetMode(Display_PRIMARY_Show, Display_Animation_Mode);
+            Blynk.syncVirtual(Animation_Vpin);
+            break;
+        }
     }
 
     // Tell the sensor methods to stop setting the primary display string.
     if (MenuDisplayMode != 0x03)
         Sensors.ShowOnDisplayPrimary = 0x00;
+
+    if (MenuDisplayMode != 0x09)
+        Animation.Stop();
 }
 
 // Android/iPhone app is giving us a new string of text to display by default.
 BLYNK_WRITE(DefaultText_Vpin) {
-    if (!param.isEmpty() && MenuDisplayMode == 0x00)
-        Display.SetString(Display_PRIMARY_Show, param.asString());
+    if (!param.isEmpty() && MenuDisplayMode == 0x00) {
+
+        // Too long for the string buffer, stream it instead.
+        if (param.getLength() > Display_MaxStringLength) {
+            Display.StreamClear();
+            Display.SetStreamSource(NULL);
+            Display.StreamAppend(param.asStr(), param.getLength() < Display_StreamSize ? param.getLength() : Display_StreamSize);
+            Display.SetMode(Display_PRIMARY_Show, Display_Stream_Mode);
+        } else {
+            Display.SetString(Display_PRIMARY_Show, param.asString());
+
+            if (Display.GetMode(Display_PRIMARY_Show) != Display_String_Mode)
+                Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+        }
+    }
 }
 
 // Android/iPhone app is giving us a new number to display by default.
@@ -264,11 +356,12 @@ BLYNK_WRITE(DefaultNumber_Vpin) {
 // Android/iPhone app is giving us new U64's to display by default.
 BLYNK_WRITE(DefaultU64_Vpin) {
     if (param.getLength() >= 16 && MenuDisplayMode == 0x02) {
+        const char *text = param.asStr();
         uint8_t charLength = param.getLength();
         uint8_t u64Count = 0;
         while (charLength >= 16) {
-            uint8_t start = u64Count * 16;
-            uint64_t image = strtoull(String(param.asString()).substring(start, start+16).c_str(), NULL, 16);
+            uint64_t image;
+            (void)Format.ParseHex(&text[u64Count * 16], 16, &image);
             Display.SetU64Image(Display_PRIMARY_Show, image, u64Count++);
             charLength -= 16;
         }
@@ -276,16 +369,44 @@ BLYNK_WRITE(DefaultU64_Vpin) {
     }
 }
 
+// Android/iPhone app is giving us a whole animation to play by default.
+BLYNK_WRITE(Animation_Vpin) {
+    if (!param.isEmpty() && MenuDisplayMode == 0x09 && Animation.Load(param.asStr()))
+        Animation.Start();
+}
+
 // Android/iPhone app is giving us a sensor ID that we need to display.
 BLYNK_WRITE(DefaultSensor_Vpin) {
-    if (!param.isEmpty() && MenuDisplayMode == 0x03)
+    if (!param.isEmpty() && MenuDisplayMode == 0x03) {
         Sensors.ShowOnDisplayPrimary = param.asInt();
+
+        // Every sensor, one after the other, read as it scrolls on.
+        if (Sensors.ShowOnDisplayPrimary == Sensors_Summary) {
+            Display.StreamClear();
+            Display.SetStreamSource(Sensors.SummarySource);
+            Display.SetMode(Display_PRIMARY_Show, Display_Stream_Mode);
+        } else if (Display.GetMode(Display_PRIMARY_Show) != Display_String_Mode) {
+            Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+        }
+    }
 }
 
 // Android/iPhone app is giving us a new brightness level to display.
 BLYNK_WRITE(Brightness_Vpin) {
     if (!param.isEmpty())
-        Display.SetBrightness(param.asInt());
+        AutoBright.SetManual(param.asInt());
+}
+
+// Android/iPhone app is giving us the lux for the dimmest and brightest automatic levels.
+BLYNK_WRITE(AutoBrightness_Vpin) {
+    if (!param.isEmpty() && param[1].asFloat() > 0)
+        AutoBright.SetCurve(param[0].asFloat(), param[1].asFloat());
+}
+
+// Android/iPhone app is giving us the seconds before an idle display goes into standby, 0 for never.
+BLYNK_WRITE(DisplayIdle_Vpin) {
+    if (!param.isEmpty())
+        Display.SetIdleTimeout(param.asInt() > 0 ? param.asInt() : 0);
 }
 
 // Android/iPhone app is giving us a new scroll rate.
@@ -322,11 +443,12 @@ BLYNK_WRITE(TempNumber_Vpin) {
 // Android/iPhone app is giving us new U64's to display temporarily.
 BLYNK_WRITE(TempU64_Vpin) {
     if (param.getLength() >= 16 ) {
+        const char *text = param.asStr();
         uint8_t charLength = param.getLength();
         uint8_t u64Count = 0;
         while (charLength >= 16) {
-            uint8_t start = u64Count * 16;
-            uint64_t image = strtoull(String(param.asString()).substring(start, start+16).c_str(), NULL, 16);
+            uint64_t image;
+            (void)Format.ParseHex(&text[u64Count * 16], 16, &image);
             Display.SetU64Image(Display_TEMPORARY_Show, image, u64Count++);
             charLength -= 16;
         }
@@ -401,10 +523,29 @@ BLYNK_WRITE(HumOffset_Vpin) {
 // There appears to be an android Joystick bug.
 // Regarding write interval.
 // There is no write interval on the IOS app. This seems to work fine.
+// The motors follow the control loop in Mobility, not the write interval.
+
+// Android/iPhone app is asking for the I2C bus, display and font report on the serial port.
+BLYNK_WRITE(I2CReport_Vpin) {
+    if (!param.isEmpty() && param.asInt()) {
+        I2CBus.PrintStats();
+        Serial.printf("Display frames: %u written, %u skipped, %u bytes saved, %u command errors\n",
+                      LightGrid::FramesWritten, LightGrid::FramesSkipped, LightGrid::BytesSaved,
+                      LightGrid::CommandErrors);
+        Font.PrintStats();
+        AutoBright.PrintStats();
+        Mobility.PrintWriteStats();
+        HeapPrint();
+    }
+}
 
 BLYNK_WRITE(MobilityStatus_Vpin) { 
     Serial.println("MobilityStatus_Vpin"); 
     Mobility.PrintMotorFaults();
+    Mobility.PrintControlStats();
+    Odometry.PrintStats();
+    DriveScript.PrintStats();
+    UdpDrive.PrintStats();
 }
 
 // Joystick
@@ -414,6 +555,7 @@ BLYNK_WRITE(MobilityJoy_Vpin) {
         int8_t speed = param[1].asInt();
 
         Mobility.SetDrive(speed, steer);
+        Display.Wake();
     }
 }
 
@@ -438,6 +580,60 @@ BLYNK_WRITE(MobilitySteer_Vpin) {
     } 
 }
 
+// Emergency stop, brake now. The joystick must go back to the middle to drive again.
+BLYNK_WRITE(MobilityStop_Vpin) {
+    if (!param.isEmpty() && param.asInt())
+        Mobility.EmergencyStop();
+}
+
+// Ramps as VSET steps per control tick, accel, decel and reverse. 0 is no limit.
+BLYNK_WRITE(MobilityRamp_Vpin) {
+    if (!param.isEmpty())
+        Mobility.SetRamp(constrain(param[0].asInt(), 0, DRV8830_MaxSpeed),
+                         constrain(param[1].asInt(), 0, DRV8830_MaxSpeed),
+                         constrain(param[2].asInt(), 0, DRV8830_MaxSpeed));
+}
+
+// A whole drive script in hex, run it now. S stops the script that is running.
+BLYNK_WRITE(DriveScript_Vpin) {
+    if (param.isEmpty())
+        return;
+
+    const char *const text = param.asStr();
+    if (text[0] == 'S' || text[0] == 's')
+        DriveScript.Stop();
+    else if (DriveScript.Load(text))
+        DriveScript.Start();
+    else
+        Serial.println("Drive script not valid");
+}
+
+// Deadman timeout in ms, 0 for off, and 1 to brake rather than coast.
+BLYNK_WRITE(Deadman_Vpin) {
+    if (!param.isEmpty())
+        Mobility.SetDeadman(constrain(param[0].asInt(), 0, 10000), param[1].asInt() != 0);
+}
+
+// Distance in mm that the obstacle reflex brakes at, 0 to turn it off.
+BLYNK_WRITE(TofBrake_Vpin) {
+    if (!param.isEmpty())
+        Sensors.SetTofBrake(constrain(param.asInt(), 0, 2000));
+}
+
+// Start the position from here, facing forwards.
+BLYNK_WRITE(OdometryReset_Vpin) {
+    if (!param.isEmpty() && param.asInt())
+        Odometry.Reset();
+}
+
+// Wheel model, full speed in mm/s, VSET dead steps and the track in mm.
+BLYNK_WRITE(OdometryModel_Vpin) {
+    if (!param.isEmpty() && param[0].asInt() > 0)
+        Odometry.SetModel(constrain(param[0].asInt(), 1, 2000),
+                          constrain(param[1].asInt(), 0, DRV8830_MaxSpeed - 1),
+                          constrain(param[2].asInt() > 0 ? param[2].asInt() : Odometry_TrackMm, 10, 1000));
+}
+
 // Front Left Address
 BLYNK_WRITE(MobilityFLAddr_Vpin) {
     if (!param.isEmpty() && param.asInt() <= DRV8830_Addr8 &&
@@ -485,12 +681,14 @@ void Switch_Handler(void) {
         SwPressA = false;
         ToggleStateA = !ToggleStateA;
         Blynk.virtualWrite(SwitchA_Vpin, 255*ToggleStateA);
+        Display.Wake();
     }
 
     if (SwPressB) {
         SwPressB = false;
         ToggleStateB = !ToggleStateB;
         Blynk.virtualWrite(SwitchB_Vpin, 255*ToggleStateB);
+        Display.Wake();
     }    
 }
 
@@ -515,7 +713,7 @@ void PushDataToBlynkServer(void) {
         case 7: Blynk.virtualWrite(Orientation_Vpin, Sensors.Orientation);
             break;
         case 8: Blynk.virtualWrite(Distance_Vpin, Sensors.GetDistance());
-            break
+            break;
         case 9: Blynk.virtualWrite(UpTimeRead_Vpin, (millis() / 1000));
             break;
         case 10: 
@@ -523,9 +721,51 @@ void PushDataToBlynkServer(void) {
             Blynk.virtualWrite(WiFiRSSI_Vpin, WiFi.RSSI());
             Blynk.virtualWrite(LocalIP_Vpin, WiFi.localIP().toString());
             break; 
+        case 11: Blynk.virtualWrite(OdometryPose_Vpin, Odometry.X(), Odometry.Y(), Odometry.HeadingDegrees());
+            break;
+        case 12: {
+            char left[Mobility_FaultSummarySize];
+            char right[Mobility_FaultSummarySize];
+            (void)Mobility.FaultSummary(Mobility_FrontLeftMotor, left, sizeof(left));
+            (void)Mobility.FaultSummary(Mobility_FrontRightMotor, right, sizeof(right));
+            Blynk.virtualWrite(MotorFaults_Vpin, left, right);
+            break;
+        }
+        case 13: {
+            char text[Mobility_LinkSummarySize];
+            (void)Mobility.LinkSummary(text, sizeof(text));
+            Blynk.virtualWrite(DriveLink_Vpin, text);
+            break;
+        }
         default: break;
     }
 
     if (state >= ThingsToPush)
         state = 0;    
-}
\ No newline at end of file
+}
+
+void HeapSample(void) {
+    uint32_t const free = ESP.getFreeHeap();
+    uint32_t const block = ESP.getMaxFreeBlockSize();
+    uint8_t const fragmentation = ESP.getHeapFragmentation();
+
+    if (free < HeapLowWater) HeapLowWater = free;
+    if (block < HeapSmallestBlock) HeapSmallestBlock = block;
+    if (fragmentation > HeapWorstFragmentation) HeapWorstFragmentation = fragmentation;
+
+#ifdef Heap_Debug
+    static uint16_t samples = 0;
+    if (++samples >= Heap_LogSamples) {
+        samples = 0;
+        Serial.printf("%lu s ", millis() / 1000);
+        HeapPrint();
+    }
+#endif
+}
+
+void HeapPrint(void) {
+    Serial.printf("Heap: %u free, %u largest block, %u%% fragmented\n",
+                  ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation());
+    Serial.printf("Heap worst: %u free, %u largest block, %u%% fragmented\n",
+                  HeapLowWater, HeapSmallestBlock, HeapWorstFragmentation);
+}
@@ -9,7 +9,6 @@
 // Header Files
 //-----------------------------------------------------------------------------
 #include <Arduino.h>				// Arduino Header file
-#include <Wire.h>					// I2C Header file
 #include <stdint.h>					// Standard Integer Header file
 #include "LightGrid.h"				// Source Header file
 
@@ -21,21 +20,66 @@
 #define DisplayCMD			0x80
 #define DimmingCMD			0xE0
 #define RamStartCMD			0x00
+#define RowMask             0x0FFFu
 
 //*****************************************************************************
 // Class Member Variable Definitions (static)
 //-----------------------------------------------------------------------------
 // private:
-uint8_t const LightGrid::_AddressI2C = 0x70;
+// The chain of panels, in scroll order.
+uint8_t LightGrid::_PanelCount = 1;
+uint8_t LightGrid::_Address[LightGrid_MaxPanels] = {LightGrid_BaseAddress};
 
 // Hardcode lookup table to know how the grid is wired.
 uint8_t const LightGrid::_RowLookup[12] = {7,6,3,2,0,1,4,5,8,11,10,9};
 uint8_t const LightGrid::_ColumnLookup[8] = {2,1,3,4,5,6,7,0};
 
+// _RowLookup as bit masks, _RowBit[row] = 1 << _RowLookup[row].
+uint16_t const LightGrid::_RowBit[12] = {
+    0x080, 0x040, 0x008, 0x004, 0x001, 0x002, 0x010, 0x020, 0x100, 0x800, 0x400, 0x200
+};
+
+// _RowLookup applied to each nibble of a 12 bit column, 
+// wired = _RowNibble[0][rows & 0xF] | _RowNibble[1][(rows >> 4) & 0xF] | _RowNibble[2][rows >> 8]
+uint16_t const LightGrid::_RowNibble[3][16] = {
+    {0x000, 0x080, 0x040, 0x0C0, 0x008, 0x088, 0x048, 0x0C8, 0x004, 0x084, 0x044, 0x0C4, 0x00C, 0x08C, 0x04C, 0x0CC},
+    {0x000, 0x001, 0x002, 0x003, 0x010, 0x011, 0x012, 0x013, 0x020, 0x021, 0x022, 0x023, 0x030, 0x031, 0x032, 0x033},
+    {0x000, 0x100, 0x800, 0x900, 0x400, 0x500, 0xC00, 0xD00, 0x200, 0x300, 0xA00, 0xB00, 0x600, 0x700, 0xE00, 0xF00}
+};
+
 // The ht16K33 ram structure is grouped by 8 columns.
 // Each bit in a u16 represents a pixel in that column.
-// Each bit is effectively a row.
-uint16_t LightGrid::_Buffer[8] = {0x0000};
+// Each bit is effectively a row, already in the wired order of _RowLookup.
+uint16_t LightGrid::_Buffer[LightGrid_MaxPanels][8] = {{0x0000}};
+
+// Each panel's HT16K33 RAM image in wire order, sent as one display priority burst.
+// A panel has its own transaction, so the queue holds at most one frame per panel.
+uint8_t LightGrid::_WireBuffer[LightGrid_MaxPanels][16] = {{0x00}};
+I2CBus_Trans_t LightGrid::_FrameTrans[LightGrid_MaxPanels];
+
+// Command bytes wait in the display queue with the frames, so they reach the
+// panel in the order they were made. Each command takes the next slot of every panel.
+I2CBus_Trans_t LightGrid::_CommandTrans[LightGrid_MaxPanels][LightGrid_CommandDepth];
+uint8_t LightGrid::_CommandNext = 0;
+
+// What the HT16K33 RAM holds once the queued frame has been sent.
+// A panel's bit in _ShadowValid is clear until a full frame has been acknowledged.
+uint8_t LightGrid::_ShadowBuffer[LightGrid_MaxPanels][16] = {{0x00}};
+uint8_t LightGrid::_ShadowValid = 0x00;
+
+// public:
+uint32_t LightGrid::FramesWritten = 0;
+uint32_t LightGrid::FramesSkipped = 0;
+uint32_t LightGrid::BytesSaved = 0;
+uint32_t LightGrid::CommandErrors = 0;
+
+// #define LightGrid_Bench     1   // Print the average cycles per frame write and column set
+#ifdef LightGrid_Bench
+static uint32_t BenchWriteCycles = 0;
+static uint32_t BenchColumnCycles = 0;
+static uint16_t BenchWrites = 0;
+static uint32_t BenchColumns = 0;
+#endif
 
 //=============================================================================
 // Class Member Method Definitions (static)
@@ -53,7 +97,39 @@ void LightGrid::Init(void) {
     // if (WriteByte(RowIntCMD | 0x00) == false)
     // 	return false;
 
-    // Nothing to do!
+    // Each panel has its own frame transaction, its RAM image is the burst.
+    for (uint8_t panel = 0; panel < LightGrid_MaxPanels; panel++) {
+        I2CBus_Trans_t *const trans = &_FrameTrans[panel];
+        I2CBus.Init(trans, _Address[panel], I2CBus_Burst, I2CBus_PriorityDisplay);
+        trans->TxData[0] = RamStartCMD;
+        trans->TxLen = 1;
+        trans->Callback = FrameDone;
+
+        for (uint8_t slot = 0; slot < LightGrid_CommandDepth; slot++) {
+            I2CBus.Init(&_CommandTrans[panel][slot], _Address[panel], I2CBus_Write, I2CBus_PriorityDisplay);
+            _CommandTrans[panel][slot].TxLen = 1;
+            _CommandTrans[panel][slot].Callback = CommandDone;
+        }
+    }
+
+    _ShadowValid = 0x00;
+}
+
+//=============================================================================
+// LightGrid::SetPanels
+//
+// Choose the chained panels. Call before Init.
+// Input:
+//	  count - Number of panels, 1 to LightGrid_MaxPanels.
+//    order - Nibble n is the address of panel n less 0x70, so the panels can be
+//            wired to the bus in any order. LightGrid_NaturalOrder for 0x70,
+//            0x71 and so on.
+//-----------------------------------------------------------------------------
+void LightGrid::SetPanels(uint8_t const count, uint32_t const order) {
+    _PanelCount = count < 1 ? 1 : (count > LightGrid_MaxPanels ? LightGrid_MaxPanels : count);
+
+    for (uint8_t panel = 0; panel < LightGrid_MaxPanels; panel++)
+        _Address[panel] = LightGrid_BaseAddress + ((order >> (panel * 4)) & 0x07);
 }
 
 bool LightGrid::Power(uint8_t const onOff) {
@@ -73,79 +149,189 @@ bool LightGrid::Brightness(uint8_t const bright) {
     return WriteByte(DimmingCMD | (0x0F & bright));
 }
 
-void LightGrid::SetPixel(uint8_t const x, uint8_t const y, uint8_t const onOff) {	
+void LightGrid::SetPixel(uint8_t const panel, uint8_t const x, uint8_t const y, uint8_t const onOff) {	
+    if (panel >= _PanelCount || x >= 8 || y >= 12)
+        return;
+
     if (onOff)
-        _Buffer[_ColumnLookup[x]] |= 0x01 << y;
+        _Buffer[panel][_ColumnLookup[x]] |= _RowBit[y];
 
     else
-        _Buffer[_ColumnLookup[x]] &= ~(0x01 << y);
+        _Buffer[panel][_ColumnLookup[x]] &= ~_RowBit[y];
 }
 
-void LightGrid::SetColumn(uint8_t const column, uint16_t const val) {
-    // Place the row data into the correct column that matches the board wiring.
-    _Buffer[_ColumnLookup[column]] = val;
+void LightGrid::SetColumn(uint8_t const panel, uint8_t const column, uint16_t const val) {
+#ifdef LightGrid_Bench
+    uint32_t const startCycles = ESP.getCycleCount();
+#endif
+    // Place the row data into the correct column and rows that match the board wiring.
+    _Buffer[panel][_ColumnLookup[column]] = _RowNibble[0][(val >> 0) & 0x0F] |
+                                            _RowNibble[1][(val >> 4) & 0x0F] |
+                                            _RowNibble[2][(val >> 8) & 0x0F];
+#ifdef LightGrid_Bench
+    BenchColumnCycles += ESP.getCycleCount() - startCycles;
+    BenchColumns++;
+#endif
 }
 
-void LightGrid::SetRow(uint8_t const row, uint8_t const val) {
-    for (uint8_t col = 0; col < 8; col++) {
-        if (val & (0x01 << col)) 
-            _Buffer[_ColumnLookup[col]] |= 0x01 << row;
+void LightGrid::SetRow(uint8_t const panel, uint8_t const row, uint8_t const val) {
+    uint16_t const rowBit = _RowBit[row];
+    uint16_t *const buffer = _Buffer[panel];
 
-        else
-            _Buffer[_ColumnLookup[col]] &= ~(0x01 << row);
+    for (uint8_t col = 0; col < 8; col++) {
+        // All ones when the bit is set, the row bit is then copied in without a branch.
+        uint16_t const set = -(uint16_t)((val >> col) & 0x01);
+        buffer[_ColumnLookup[col]] = (buffer[_ColumnLookup[col]] & ~rowBit) | (set & rowBit);
     }
 }
 
+// Queue the frame on the I2C bus behind the motor, distance and accelerometer traffic.
+// All the panels go out in one pass, each sends only the range of its RAM
+// bytes that changed, so a panel that did not change costs nothing.
+// Returns false if a panel could not be queued.
 bool LightGrid::WriteBuffer(void) {
-    Wire.beginTransmission(_AddressI2C);
+    bool success = true;
 
-    if (Wire.write(RamStartCMD) != 1)
-        return false;
+#ifdef LightGrid_Bench
+    uint32_t const startCycles = ESP.getCycleCount();
+#endif
+    for (uint8_t panel = 0; panel < _PanelCount; panel++)
+        success &= WritePanel(panel);
+#ifdef LightGrid_Bench
+    // Includes any queued traffic sent to make room, see WritePanel.
+    BenchWriteCycles += ESP.getCycleCount() - startCycles;
+    if (++BenchWrites >= 256) {
+        Serial.printf("LightGrid %u cycles/write, %u cycles/column\n", BenchWriteCycles / BenchWrites,
+                      BenchColumns ? BenchColumnCycles / BenchColumns : 0u);
+        BenchWriteCycles = 0;
+        BenchColumnCycles = 0;
+        BenchWrites = 0;
+        BenchColumns = 0;
+    }
+#endif
+
+    return success;
+}
+
+void LightGrid::ClearBuffer(void) {
+    memset(_Buffer, 0, sizeof(_Buffer));
+}
+
+void LightGrid::InvertBuffer(void) {
+    for (uint8_t panel = 0; panel < _PanelCount; panel++) {
+        for (uint8_t col = 0; col < 8; col++) {
+            _Buffer[panel][col] ^= RowMask;
+        }
+    }
+}
+
+// Pixels turned on in the buffer, across every panel.
+uint16_t LightGrid::LitPixels(void) {
+    uint16_t count = 0;
+
+    for (uint8_t panel = 0; panel < _PanelCount; panel++) {
+        for (uint8_t col = 0; col < 8; col++) {
+            count += __builtin_popcount(_Buffer[panel][col] & RowMask);
+        }
+    }
+
+    return count;
+}
+
+// private:
+bool LightGrid::WritePanel(uint8_t const panel) {
+    uint8_t *const wire = _WireBuffer[panel];
+    uint8_t *const shadow = _ShadowBuffer[panel];
+    I2CBus_Trans_t *const trans = &_FrameTrans[panel];
+    bool const shadowValid = _ShadowValid & (1u << panel);
 
     // Write out all 8 columns, half at a time (8 bits)
     for (uint8_t col = 0; col < 8; col++) {	
-        uint16_t correctRowData = 0x0000u;
+        wire[col*2 + 0] = (uint8_t)(_Buffer[panel][col] >> 0);
+        wire[col*2 + 1] = (uint8_t)(_Buffer[panel][col] >> 8);
+    }
+
+    uint8_t first = sizeof(_WireBuffer[0]);
+    uint8_t last = 0;
 
-        for (uint8_t row = 0; row < 12; row++) {
-            if (_Buffer[col] & (0x0001u << row))
-                correctRowData |= 0x0001 << _RowLookup[row];
+    for (uint8_t i = 0; i < sizeof(_WireBuffer[0]); i++) {
+        if (!shadowValid || wire[i] != shadow[i]) {
+            if (first > i) first = i;
+            last = i;
+            shadow[i] = wire[i];
         }
+    }
+    _ShadowValid |= 1u << panel;
 
-        if (Wire.write((uint8_t)(correctRowData >> 0)) == 0)
-            return false;
+    // A frame still waiting in the queue sends the latest image, widen it to cover both changes.
+    if (trans->Status == I2CBus_Pending) {
+        uint8_t const pendFirst = trans->TxData[0] - RamStartCMD;
+        uint8_t const pendLast = pendFirst + trans->BurstLen - 1;
 
-        if (Wire.write((uint8_t)(correctRowData >> 8)) == 0)
-            return false;
+        if (first > pendFirst) first = pendFirst;
+        if (last < pendLast) last = pendLast;
     }
 
-    if (Wire.endTransmission() != 0)
-          return false;
-    
-      return true;
-}
+    if (first > last) {
+        FramesSkipped++;
+        return true;
+    }
 
-void LightGrid::ClearBuffer(void) {
-    for (uint8_t col = 0; col < 8; col++) {
-        _Buffer[col] = 0x0000;
+    trans->Addr = _Address[panel];
+    trans->TxData[0] = RamStartCMD + first;
+    trans->BurstPtr = &wire[first];
+    trans->BurstLen = last - first + 1;
+
+    // Commands to every panel can fill the queue, send them first rather
+    // than drop the frame. A frame still waiting keeps its place.
+    if (trans->Status != I2CBus_Pending && I2CBus.Room(I2CBus_PriorityDisplay) == 0)
+        I2CBus.Run();
+
+    if (!I2CBus.Submit(trans)) {
+        _ShadowValid &= ~(1u << panel);
+        return false;
     }
+
+    return true;
 }
 
-void LightGrid::InvertBuffer(void) {
-    for (uint8_t col = 0; col < 8; col++) {
-        _Buffer[col] = ~_Buffer[col];
+void LightGrid::FrameDone(I2CBus_Trans_t *const trans) {
+    if (trans->Status == I2CBus_Ok) {
+        FramesWritten++;
+        BytesSaved += sizeof(_WireBuffer[0]) - trans->BurstLen;
+    } else {
+        // The chip RAM is unknown, send the whole frame next time.
+        _ShadowValid &= ~(1u << (trans - _FrameTrans));
     }
 }
 
-// private:
+void LightGrid::CommandDone(I2CBus_Trans_t *const trans) {
+    if (trans->Status != I2CBus_Ok)
+        CommandErrors++;
+}
+
+// Queue a command byte to every panel, behind any frame already waiting.
+// The command is sent when the bus next runs, a failure counts in CommandErrors.
 bool LightGrid::WriteByte(uint8_t const byte) {
-    Wire.beginTransmission(_AddressI2C);
-    
-    if (Wire.write(byte) == 1) {
-          if (Wire.endTransmission() == 0)
-              return true;
+    bool success = true;
+    uint8_t const slot = _CommandNext;
+    _CommandNext = (_CommandNext + 1) % LightGrid_CommandDepth;
+
+    for (uint8_t panel = 0; panel < _PanelCount; panel++) {
+        I2CBus_Trans_t *const trans = &_CommandTrans[panel][slot];
+
+        // No room, or the slot still holds an older command. Send what is
+        // waiting first, rather than drop the command or let it jump ahead.
+        if (trans->Status == I2CBus_Pending || I2CBus.Room(I2CBus_PriorityDisplay) == 0)
+            I2CBus.Run();
+
+        trans->Addr = _Address[panel];
+        trans->TxData[0] = byte;
+
+        success &= I2CBus.Submit(trans);
     }
 
-    return false;
+    return success;
 }
 
 // LightGrid.c EOF
\ No newline at end of file
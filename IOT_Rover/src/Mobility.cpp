@@ -10,78 +10,553 @@
 // ----------------------------------------------------------------------------
 #include "Mobility.h"  // Source Header file
 #include <Arduino.h>   // Arduino Header file
+#include "Odometry.h"  // Odometry Header file
+#include "Format.h"    // Format Header file
 #include <Wire.h>      // I2C Header file
+#include <Blynk/BlynkTimer.h>  // Timer Header file
 
 //*****************************************************************************
 // Private Macro Definitions
 //-----------------------------------------------------------------------------
-#define MaxSteer 10
-#define SpeedDivisor (MaxSteer / 2)
 
 //*****************************************************************************
 // Publicly Accessible Global Variable Definitions
 //-----------------------------------------------------------------------------
 MobilityClass Mobility{DRV8830_Addr0, DRV8830_Addr2};
 
+//*****************************************************************************
+// Externally Defined Global Variables
+//-----------------------------------------------------------------------------
+extern BlynkTimer GlobalTimer;
+
 //=============================================================================
 // Class Member Method Definitions
 //-----------------------------------------------------------------------------
 // public:
-bool MobilityClass::SetDrive(int8_t const speed, int8_t const steer) {
-    int8_t majorSpeed = speed;
-    int8_t minorSpeed = 0;
-
-    uint8_t speedAbs = 0;
-    uint8_t steerAbs = 0;
-    uint8_t subMul = 0;
-    uint8_t subAmmount = 0;
-
-    if (majorSpeed == 0) {
-        this->_Motors[Mobility_FrontLeftMotor].SetCoast();
-        this->_Motors[Mobility_FrontRightMotor].SetCoast();
+// Start the control loop, the motors coast until the first setpoint.
+void MobilityClass::Begin() {
+    Odometry.Reset();
+    (void)this->ApplyDrive(0, 0);
+    this->_TickUs = micros();
+    (void)GlobalTimer.setInterval(Mobility_ControlPeriodMs, ControlTick);
+}
+
+// Any input source, the joystick or the speed and steer sliders.
+void MobilityClass::SetDrive(int8_t const speed, int8_t const steer) {
+    uint32_t const nowMs = millis();
+
+    // A pause with the joystick let go is not a gap in the link.
+    if (this->_InputMoving)
+        CountLink(this->_GapHist, nowMs - this->_InputMs);
+
+    this->_Manual = true;
+    this->_InputMoving = speed != 0 || steer != 0;
+    this->_InputMs = nowMs;
+
+    this->Override(Mobility_ManualOverride);
+    this->Setpoint(speed, steer);
+}
+
+// A setpoint from a drive script, a manual one still overrides it. The next
+// setpoint after a script brake drives again, whatever the speed. A stop
+// from anything else is only let go by a zero setpoint.
+void MobilityClass::ScriptDrive(int8_t const speed, int8_t const steer) {
+    this->_Manual = false;
+    if (this->_ScriptStop) this->Release();
+    this->Setpoint(speed, steer);
+}
+
+// The largest change in VSET steps each control tick, 0 to change at once.
+void MobilityClass::SetRamp(uint8_t const accel, uint8_t const decel,
+                            uint8_t const reverse) {
+    this->_AccelStep = accel;
+    this->_DecelStep = decel;
+    this->_ReverseStep = reverse;
+}
+
+//=============================================================================
+// Mobility::EmergencyStop
+//
+// Brake both motors now, without the ramps or waiting for the next tick.
+// The motors stay braked until a setpoint of zero speed and steer is given,
+// so a joystick still held over, or turned to spin, does not drive off again.
+//-----------------------------------------------------------------------------
+void MobilityClass::EmergencyStop() {
+    this->Override(Mobility_ManualOverride);
+    this->Brake();
+}
+
+// The brake of an emergency stop, as a drive script step.
+void MobilityClass::ScriptBrake() {
+    this->Brake();
+    this->_ScriptStop = true;
+}
+
+//=============================================================================
+// Mobility::SetObstacle
+//
+// The obstacle reflex, given by the distance sensor after every reading.
+// While something is ahead no wheel may turn forwards. A wheel already going
+// forwards brakes at once, without the ramp or waiting for the next tick.
+// Reversing and turning away on the other wheel still work.
+// Output:
+//	  bool - true if this reading braked a wheel.
+//-----------------------------------------------------------------------------
+bool MobilityClass::SetObstacle(bool const ahead) {
+    if (ahead == this->_Blocked) return false;
+
+    this->_Blocked = ahead;
+    if (!ahead) return false;
+
+    bool const moving = this->_Output[0] > 0 || this->_Output[1] > 0;
+    (void)this->ApplyDrive(this->_SetSpeed, this->_SetSteer);
+
+    if (moving) this->Override(Mobility_ObstacleOverride);
+    return moving;
+}
+
+void MobilityClass::PrintControlStats() {
+    Serial.printf("Motor control: %u ticks, interval %u - %u us, %u us latency\n",
+                  this->_Ticks, this->_Ticks > 1 ? this->_IntervalMinUs : 0,
+                  this->_IntervalMaxUs, this->_LatencyMaxUs);
+    Serial.printf("Setpoints: %u received, %u dropped\n", this->_Setpoints,
+                  this->_Dropped);
+
+    char text[Mobility_LinkSummarySize];
+    (void)this->LinkSummary(text, sizeof(text));
+    Serial.printf("Drive input: %s, age max %u ms\n", text, this->_AgeMaxMs);
+    Serial.print("Input gaps:");
+    for (uint8_t i = 0; i < Mobility_LinkBuckets; i++) Serial.printf(" %u", this->_GapHist[i]);
+    Serial.print(", ages:");
+    for (uint8_t i = 0; i < Mobility_LinkBuckets; i++) Serial.printf(" %u", this->_AgeHist[i]);
+    Serial.println();
+
+    this->_Ticks = 0;
+    this->_IntervalMinUs = UINT32_MAX;
+    this->_IntervalMaxUs = 0;
+    this->_LatencyMaxUs = 0;
+    this->_Setpoints = 0;
+    this->_Dropped = 0;
+    this->_AgeMaxMs = 0;
+}
+
+//=============================================================================
+// Mobility::LinkSummary
+//
+// The manual input timing as one line, the gap between setpoints and the age
+// of the setpoint driven on, from the rolling histograms. Each figure is the
+// top of its histogram bucket.
+// Output:
+//	  uint8_t - The length of the text.
+//-----------------------------------------------------------------------------
+uint8_t MobilityClass::LinkSummary(char *const buffer, uint8_t const size) const {
+    uint8_t length = Format.Text(buffer, size, 0, "gap p50 ");
+    length = LinkBound(buffer, size, length, Percentile(this->_GapHist, 50));
+    length = Format.Text(buffer, size, length, " p90 ");
+    length = LinkBound(buffer, size, length, Percentile(this->_GapHist, 90));
+    length = Format.Text(buffer, size, length, " ms, age p90 ");
+    length = LinkBound(buffer, size, length, Percentile(this->_AgeHist, 90));
+    length = Format.Text(buffer, size, length, " max ");
+    length = LinkBound(buffer, size, length, Percentile(this->_AgeHist, 100));
+    length = Format.Text(buffer, size, length, " ms, deadman ");
+    return Format.Unsigned(buffer, size, length, this->_DeadmanTrips);
+}
+
+// private:
+void MobilityClass::Brake() {
+    this->_Stopped = true;
+    this->_ScriptStop = false;
+    this->_SetPending = false;
+    this->_SetSpeed = 0;
+    this->_SetSteer = 0;
+    (void)this->ApplyDrive(0, 0);
+
+    if (this->_Forward) {
+        this->_Forward = false;
+        if (this->_ForwardFn) this->_ForwardFn(false);
+    }
+}
+
+// Let go of a brake, the motors ramp up again from rest.
+void MobilityClass::Release() {
+    this->_Stopped = false;
+    this->_ScriptStop = false;
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++)
+        this->_Output[i] = 0;
+}
+
+// The setpoint from any source, used by the next control tick.
+void MobilityClass::Setpoint(int8_t const speed, int8_t const steer) {
+    // Releasing the joystick after an emergency stop lets the motors run again.
+    // A spin on the spot is not a release, it needs speed and steer at zero.
+    if (this->_Stopped && speed == 0 && steer == 0) this->Release();
+
+    if (this->_SetPending) {
+        this->_Dropped++;
     } else {
-        steerAbs = abs(steer);
-
-        if (steerAbs == 0) {
-            minorSpeed = majorSpeed;
-        } else if (steerAbs == 5) {
-            minorSpeed = 0;
-        } else if (steerAbs == 10) {
-            minorSpeed = majorSpeed * -1;
-        } else {
-            speedAbs = abs(majorSpeed);
-            subMul = speedAbs / SpeedDivisor;
-            subAmmount = steerAbs * subMul;
-            minorSpeed = speedAbs - subAmmount;
-
-            if (majorSpeed < 0) minorSpeed *= -1;
+        this->_SetPending = true;
+        this->_SetUs = micros();
+    }
+
+    this->_SetSpeed = speed;
+    this->_SetSteer = steer;
+    this->_Setpoints++;
+
+    // Let the obstacle sensor know straight away when forward driving starts or ends.
+    if ((speed > 0) != this->_Forward) {
+        this->_Forward = speed > 0;
+        if (this->_ForwardFn) this->_ForwardFn(this->_Forward);
+    }
+}
+
+//=============================================================================
+// Mobility::CheckInput
+//
+// Each control tick while a manual setpoint is driving, count its age and
+// stop once it is older than the deadman timeout. Coasting puts both bridges
+// in standby on this tick, without the ramp down. A brake stays on until the
+// joystick is let go, like an emergency stop, so a link that comes back with
+// the joystick still held over does not drive off again.
+//-----------------------------------------------------------------------------
+void MobilityClass::CheckInput() {
+    if (!this->_Manual || (this->_SetSpeed == 0 && this->_SetSteer == 0))
+        return;
+
+    uint32_t const ageMs = millis() - this->_InputMs;
+    CountLink(this->_AgeHist, ageMs);
+    if (ageMs > this->_AgeMaxMs) this->_AgeMaxMs = ageMs;
+
+    if (this->_DeadmanMs == 0 || ageMs <= this->_DeadmanMs)
+        return;
+
+    this->_DeadmanTrips++;
+    Serial.printf("Deadman, no drive input for %u ms\n", ageMs);
+
+    if (this->_DeadmanBrake) {
+        this->Brake();
+        return;
+    }
+
+    this->Setpoint(0, 0);
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++)
+        this->_Output[i] = 0;
+}
+
+// Count a time in its histogram bucket, halving the histogram now and then so
+// it follows the link as it is now.
+void MobilityClass::CountLink(uint16_t *const hist, uint32_t const ms) {
+    uint8_t bucket = 0;
+    uint32_t limit = Mobility_LinkBucketMs;
+    uint16_t total = 0;
+
+    while (bucket < Mobility_LinkBuckets - 1 && ms >= limit) {
+        bucket++;
+        limit <<= 1;
+    }
+    hist[bucket]++;
+
+    for (uint8_t i = 0; i < Mobility_LinkBuckets; i++) total += hist[i];
+
+    if (total >= Mobility_LinkWindow)
+        for (uint8_t i = 0; i < Mobility_LinkBuckets; i++) hist[i] >>= 1;
+}
+
+// The top of the bucket that holds the percent point, 0 if the histogram is
+// empty and UINT16_MAX for the last bucket.
+uint16_t MobilityClass::Percentile(uint16_t const *const hist, uint8_t const percent) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < Mobility_LinkBuckets; i++) total += hist[i];
+
+    if (total == 0)
+        return 0;
+
+    uint32_t const wanted = (total * percent + 99) / 100;
+    uint32_t count = 0;
+    uint16_t limit = Mobility_LinkBucketMs;
+
+    for (uint8_t i = 0; i < Mobility_LinkBuckets - 1; i++, limit <<= 1) {
+        count += hist[i];
+        if (count >= wanted)
+            return limit;
+    }
+
+    return UINT16_MAX;
+}
+
+// A Percentile as text, "<100", ">1600" for the last bucket or "-" for none.
+uint8_t MobilityClass::LinkBound(char *const buffer, uint8_t const size, uint8_t const length,
+                                 uint16_t const ms) {
+    if (ms == 0)
+        return Format.Text(buffer, size, length, "-");
+
+    if (ms == UINT16_MAX)
+        return Format.Unsigned(buffer, size, Format.Text(buffer, size, length, ">"),
+                               Mobility_LinkBucketMs << (Mobility_LinkBuckets - 2));
+
+    return Format.Unsigned(buffer, size, Format.Text(buffer, size, length, "<"), ms);
+}
+
+void MobilityClass::ControlTick() { Mobility.Control(); }
+
+// One tick of the control loop, keep the timing and apply the setpoint.
+void MobilityClass::Control() {
+    uint32_t const nowUs = micros();
+    uint32_t const intervalUs = nowUs - this->_TickUs;
+    this->_TickUs = nowUs;
+
+    if (this->_Ticks++ > 0) {
+        if (intervalUs < this->_IntervalMinUs) this->_IntervalMinUs = intervalUs;
+        if (intervalUs > this->_IntervalMaxUs) this->_IntervalMaxUs = intervalUs;
+    }
+
+    this->CheckInput();
+
+    if (this->_SetPending) {
+        this->_SetPending = false;
+        if (nowUs - this->_SetUs > this->_LatencyMaxUs)
+            this->_LatencyMaxUs = nowUs - this->_SetUs;
+    }
+
+    if (++this->_PollTicks >= (this->IsDriving() ? Mobility_FaultPollDrive : Mobility_FaultPollIdle)) {
+        this->_PollTicks = 0;
+        this->PollFaults();
+    }
+
+    // Every tick, the motor driver skips a control value it already has.
+    (void)this->ApplyDrive(this->_SetSpeed, this->_SetSteer);
+
+    Odometry.Step(this->_Output[Mobility_FrontLeftMotor],
+                  this->_Output[Mobility_FrontRightMotor]);
+}
+
+//=============================================================================
+// Mobility::Mix
+//
+// Arcade to differential drive. The left wheel gets speed + steer and the
+// right wheel speed - steer. When a wheel would go past full scale both are
+// scaled down by the same amount, so the turn keeps its shape.
+// Input:
+//	  speed - Forward is positive, -100 to 100.
+//    steer - Right is positive, -100 to 100. With no speed it spins in place.
+//    left, right - Set to the wheel speeds in VSET steps, -57 to 57.
+//-----------------------------------------------------------------------------
+void MobilityClass::Mix(int8_t const speed, int8_t const steer,
+                        int8_t *const left, int8_t *const right) {
+    int16_t const s = constrain(speed, -Mobility_InputMax, Mobility_InputMax);
+    int16_t const t = constrain(steer, -Mobility_InputMax, Mobility_InputMax);
+    int16_t const l = s + t;
+    int16_t const r = s - t;
+
+    // Full scale is the input range, or the faster wheel if it is past it.
+    int16_t scale = abs(l) > abs(r) ? abs(l) : abs(r);
+    if (scale < Mobility_InputMax) scale = Mobility_InputMax;
+
+    // Rounded to the nearest step, halves away from zero.
+    int32_t const lScaled = (int32_t)l * DRV8830_MaxSpeed * 2;
+    int32_t const rScaled = (int32_t)r * DRV8830_MaxSpeed * 2;
+    *left = (lScaled + (l < 0 ? -scale : scale)) / (scale * 2);
+    *right = (rScaled + (r < 0 ? -scale : scale)) / (scale * 2);
+}
+
+bool MobilityClass::ApplyDrive(int8_t const speed, int8_t const steer) {
+    int8_t target[Mobility_MotorCount] = {0, 0};
+
+    this->_Speed = this->_Stopped ? 0 : speed;
+    this->_Steer = this->_Stopped ? 0 : steer;
+
+    Mix(speed, steer, &target[Mobility_FrontLeftMotor],
+        &target[Mobility_FrontRightMotor]);
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++) {
+        if (this->_Stopped) {
+            this->_Output[i] = 0;
+            this->_Motors[i].SetBrake();
+            continue;
         }
 
-        if (steer >= 0) {
-            this->_Motors[Mobility_FrontLeftMotor].SetSpeedDir(majorSpeed);
-            this->_Motors[Mobility_FrontRightMotor].SetSpeedDir(minorSpeed);
-        } else {
-            this->_Motors[Mobility_FrontRightMotor].SetSpeedDir(majorSpeed);
-            this->_Motors[Mobility_FrontLeftMotor].SetSpeedDir(minorSpeed);
+        if (this->_Blocked) {
+            if (target[i] > 0) target[i] = 0;
+            if (this->_Output[i] > 0) this->_Output[i] = 0;
         }
+
+        // A motor resting after an over temperature shutdown coasts.
+        if (this->_Cooling[i]) {
+            target[i] = 0;
+            this->_Output[i] = 0;
+        }
+
+        target[i] = constrain(target[i], -this->_Limit[i], this->_Limit[i]);
+
+        this->_Output[i] = this->Ramp(this->_Output[i], target[i]);
+
+        if (this->_Output[i] == 0 && this->_Blocked)
+            this->_Motors[i].SetBrake();
+        else if (this->_Output[i] == 0)
+            this->_Motors[i].SetCoast();
+        else
+            this->_Motors[i].SetSpeedDir(this->_Output[i]);
     }
 
-    bool success[4] = {
-        this->_Motors[Mobility_FrontLeftMotor].ClearFaultReg(),
-        this->_Motors[Mobility_FrontLeftMotor].WriteControlReg(),
-        this->_Motors[Mobility_FrontRightMotor].ClearFaultReg(),
-        this->_Motors[Mobility_FrontRightMotor].WriteControlReg()};
+    return this->WriteMotors();
+}
+
+bool MobilityClass::WriteMotors() {
+    // Only a fault that has been read back needs clearing, and only a new
+    // control value needs writing.
+    bool success = true;
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++) {
+        DRV8830Class &motor = this->_Motors[i];
+
+        if (motor.FaultSeen() && !this->_Cooling[i])
+            success &= motor.ClearFaultReg();
 
-    return (success[0] && success[1] && success[2] && success[3]);
+        bool const wasDriving = motor.Driving();
+        bool const written = motor.WriteControlReg();
+
+        // A latched OCP or UVLO leaves the bridge off, the chip refuses the
+        // write or takes it and does nothing. Read the FAULT register when a
+        // write fails or the motor starts from rest, so that a fault found is
+        // cleared and the control value written again on the next tick.
+        if (!written || (!wasDriving && motor.Driving()))
+            (void)motor.GetFaultReg(NULL);
+
+        success &= written;
+    }
+
+    return success;
+}
+
+// One tick of the ramp for a motor. Going through zero to change direction
+// slows at the reverse rate, then speeds up the other way at the accel rate.
+int8_t MobilityClass::Ramp(int8_t const output, int8_t const target) const {
+    int8_t goal = target;
+    uint8_t step = this->_AccelStep;
+
+    if ((output > 0 && target < 0) || (output < 0 && target > 0)) {
+        goal = 0;
+        step = this->_ReverseStep;
+    } else if (abs(target) < abs(output)) {
+        step = this->_DecelStep;
+    }
+
+    if (step == 0 || abs(goal - output) <= step)
+        return goal;
+
+    return goal > output ? output + step : output - step;
+}
+
+//=============================================================================
+// Mobility::PollFaults
+//
+// Read each FAULT register and act on what it shows.
+//  ILIMIT - A second one within Mobility_ILimitWindowMs takes some VSET off
+//           that motor, it is given back a step at a time once it is quiet.
+//           A read that fails is not quiet, it starts the quiet time again.
+//  OTS    - The motor coasts for Mobility_ThermalCoolMs, then the fault is
+//           cleared and it ramps up again.
+//  OCP and UVLO are counted, and cleared by the next control write.
+//-----------------------------------------------------------------------------
+void MobilityClass::PollFaults() {
+    uint32_t const nowMs = millis();
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++) {
+        DRV8830Class &motor = this->_Motors[i];
+        uint8_t fault = 0;
+
+        if (this->_Cooling[i]) {
+            if (nowMs - this->_CoolMs[i] >= Mobility_ThermalCoolMs) {
+                this->_Cooling[i] = false;
+                Serial.printf("%lu Motor %u cooled, back on\n", (unsigned long)nowMs, i);
+            }
+            continue;
+        }
+
+        // No answer is not a quiet motor, start the quiet time again.
+        if (!motor.GetFaultReg(&fault)) {
+            this->_RecoverMs[i] = nowMs;
+            continue;
+        }
+
+        if (!(fault & DRV8830_FaultBit)) {
+            // Quiet, give a step of VSET back.
+            if (this->_Limit[i] < DRV8830_MaxSpeed && nowMs - this->_RecoverMs[i] >= Mobility_LimitRecoverMs) {
+                this->_Limit[i] = this->_Limit[i] + Mobility_LimitBackoff < DRV8830_MaxSpeed ? this->_Limit[i] + Mobility_LimitBackoff : DRV8830_MaxSpeed;
+                this->_RecoverMs[i] = nowMs;
+            }
+            continue;
+        }
+
+        Serial.printf("%lu Motor %u fault 0x%02x\n", (unsigned long)nowMs, i, fault);
+
+        if (fault & DRV8830_FaultILimit) {
+            if (nowMs - this->_ILimitMs[i] < Mobility_ILimitWindowMs && this->_Limit[i] > Mobility_LimitFloor)
+                this->_Limit[i] = this->_Limit[i] - Mobility_LimitBackoff > Mobility_LimitFloor ? this->_Limit[i] - Mobility_LimitBackoff : Mobility_LimitFloor;
+            this->_ILimitMs[i] = nowMs;
+            this->_RecoverMs[i] = nowMs;
+        }
+
+        if (fault & DRV8830_FaultOts) {
+            this->_Cooling[i] = true;
+            this->_CoolMs[i] = nowMs;
+        }
+    }
+}
+
+// One motor's fault counts and VSET limit, for the app and the portal.
+uint8_t MobilityClass::FaultSummary(uint8_t const index, char *const buffer, uint8_t const size) const {
+    static const char *const Names[DRV8830_FaultKinds] = {" OCP ", ", UVLO ", ", OTS ", ", ILIMIT "};
+    DRV8830Class const &motor = this->_Motors[index];
+    uint8_t length = Format.Text(buffer, size, 0, index == Mobility_FrontLeftMotor ? "FL:" : "FR:");
+
+    for (uint8_t kind = 0; kind < DRV8830_FaultKinds; kind++) {
+        length = Format.Text(buffer, size, length, Names[kind]);
+        length = Format.Unsigned(buffer, size, length, motor.FaultCount((DRV8830_FaultKind)kind));
+    }
+
+    length = Format.Text(buffer, size, length, ", VSET max ");
+    length = Format.Unsigned(buffer, size, length, this->_Limit[index]);
+
+    if (this->_Cooling[index])
+        length = Format.Text(buffer, size, length, ", cooling");
+
+    return length;
 }
 
 void MobilityClass::PrintMotorFaults() {
-    uint8_t fault = 0;
-    this->_Motors[Mobility_FrontLeftMotor].GetFaultReg(&fault);
-    Serial.println(fault, HEX);
-    fault = 0;
-    this->_Motors[Mobility_FrontRightMotor].GetFaultReg(&fault);
-    Serial.println(fault, HEX);
+    char text[Mobility_FaultSummarySize];
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++) {
+        uint8_t fault = 0;
+        this->_Motors[i].GetFaultReg(&fault);
+        (void)this->FaultSummary(i, text, sizeof(text));
+        Serial.printf("%s, FAULT 0x%02x, last 0x%02x at %u ms\n", text, fault,
+                      this->_Motors[i].LastFault(), this->_Motors[i].FaultMs());
+    }
+}
+
+// Control writes sent to the motors, and those skipped as the chip already had the value.
+uint32_t MobilityClass::WritesIssued() const {
+    uint32_t issued = 0;
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++)
+        issued += this->_Motors[i].WritesIssued();
+
+    return issued;
+}
+
+uint32_t MobilityClass::WritesSuppressed() const {
+    uint32_t suppressed = 0;
+
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++)
+        suppressed += this->_Motors[i].WritesSuppressed();
+
+    return suppressed;
+}
+
+void MobilityClass::PrintWriteStats() {
+    Serial.printf("Motor control writes: %u issued, %u suppressed\n", this->WritesIssued(),
+                  this->WritesSuppressed());
 }
 
 // Mobility.cpp EOF
\ No newline at end of file
@@ -0,0 +1,176 @@
+//////////////////////////////// Odometry.cpp /////////////////////////////////
+// Filename:	Odometry.cpp
+// Description: Dead reckoning of the rover position from the wheel speeds.
+// Author:		Danon Bradford
+// Date:		2020-05-09
+//////////////////////////////// Odometry.cpp /////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include "Mobility.h"				// Mobility Header file
+#include "Odometry.h"				// Source Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define SineShift       14          // The sine table is 1.0 = 16384
+#define HalfTurn        32768u      // Binary angle of 180 degrees
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+OdometryClass Odometry;
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// A quarter turn of sine in 64 steps, 1.0 = 16384.
+static const int16_t SineQuarter[65] PROGMEM = {
+        0,   402,   804,  1205,  1606,  2006,  2404,  2801,
+     3196,  3590,  3981,  4370,  4756,  5139,  5520,  5897,
+     6270,  6639,  7005,  7366,  7723,  8076,  8423,  8765,
+     9102,  9434,  9760, 10080, 10394, 10702, 11003, 11297,
+    11585, 11866, 12140, 12406, 12665, 12916, 13160, 13395,
+    13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978,
+    15137, 15286, 15426, 15557, 15679, 15791, 15893, 15986,
+    16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379,
+    16384
+};
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+// Micrometres a wheel moves in one control tick, indexed by VSET steps.
+uint16_t OdometryClass::_TickUm[DRV8830_MaxSpeed + 1];
+
+// Binary angle per micrometre of wheel difference, in 1/16777216ths.
+int32_t OdometryClass::_TurnScale = 0;
+
+int32_t OdometryClass::_XUm = 0;
+int32_t OdometryClass::_YUm = 0;
+uint32_t OdometryClass::_Heading = 0;
+uint32_t OdometryClass::_TravelUm = 0;
+uint32_t OdometryClass::_TravelMm = 0;
+
+bool OdometryClass::_AccelSeen = false;
+bool OdometryClass::_Driving = false;
+uint32_t OdometryClass::_MotionMs = 0;
+uint32_t OdometryClass::_StallTicks = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+void OdometryClass::Reset() {
+    _XUm = 0;
+    _YUm = 0;
+    _Heading = 0;
+    _TravelUm = 0;
+    _TravelMm = 0;
+    _StallTicks = 0;
+
+    if (_TurnScale == 0)
+        SetModel(Odometry_FullSpeedMmS, Odometry_DeadSteps, Odometry_TrackMm);
+}
+
+//=============================================================================
+// Odometry::SetModel
+//
+// Calibrate the wheel speed for each VSET step. The speed is taken to rise in
+// a straight line from nothing at the dead steps to full speed at VSET 57.
+// Input:
+//	  fullSpeedMmS - Wheel speed at full VSET.
+//    deadSteps    - The wheel does not turn at or below this many steps.
+//    trackMm      - Distance between the wheels, at least 10 mm.
+//-----------------------------------------------------------------------------
+void OdometryClass::SetModel(uint16_t const fullSpeedMmS, uint8_t const deadSteps, uint16_t const trackMm) {
+    uint8_t const dead = deadSteps < DRV8830_MaxSpeed ? deadSteps : DRV8830_MaxSpeed - 1;
+    uint32_t const fullTickUm = (uint32_t)fullSpeedMmS * Mobility_ControlPeriodMs;
+    uint16_t const track = trackMm < 10 ? 10 : trackMm;
+
+    for (uint8_t steps = 0; steps <= DRV8830_MaxSpeed; steps++) {
+        uint32_t const tickUm = steps <= dead ? 0 : (fullTickUm * (steps - dead) * 2 + DRV8830_MaxSpeed - dead) / ((DRV8830_MaxSpeed - dead) * 2);
+        _TickUm[steps] = tickUm > UINT16_MAX ? UINT16_MAX : tickUm;
+    }
+
+    // 65536 binary angle over the circle the wheels turn on, 2 pi track.
+    _TurnScale = (int32_t)(65536.0 * 16777216.0 / (2.0 * PI * track * 1000.0) + 0.5);
+}
+
+// The accelerometer motion count, after every reading.
+void OdometryClass::SetMotion(uint16_t const motion) {
+    _AccelSeen = true;
+
+    if (motion > Odometry_MotionLimit)
+        _MotionMs = millis();
+}
+
+//=============================================================================
+// Odometry::Step
+//
+// One control tick of driving. The heading used for the move is half way
+// through the turn made this tick.
+// Input:
+//	  left, right - The VSET steps each wheel is driven at, -57 to 57.
+//-----------------------------------------------------------------------------
+void OdometryClass::Step(int8_t const left, int8_t const right) {
+    if (left == 0 && right == 0) {
+        _Driving = false;
+        return;
+    }
+
+    // Give the accelerometer time to see the start of the move.
+    if (!_Driving) {
+        _Driving = true;
+        _MotionMs = millis();
+    }
+
+    if (_AccelSeen && millis() - _MotionMs > Odometry_StallMs) {
+        _StallTicks++;
+        return;
+    }
+
+    int32_t const leftUm = left < 0 ? -(int32_t)_TickUm[-left] : _TickUm[left];
+    int32_t const rightUm = right < 0 ? -(int32_t)_TickUm[-right] : _TickUm[right];
+    int32_t const forwardUm = (leftUm + rightUm) / 2;
+    int32_t const turn = ((int64_t)(rightUm - leftUm) * _TurnScale) >> 8;
+    uint16_t const middle = (_Heading + turn / 2) >> 16;
+
+    _XUm += ((int32_t)forwardUm * Sine(middle + HalfTurn / 2) + (1 << (SineShift - 1))) >> SineShift;
+    _YUm += ((int32_t)forwardUm * Sine(middle) + (1 << (SineShift - 1))) >> SineShift;
+    _Heading += turn;
+
+    _TravelUm += forwardUm < 0 ? -forwardUm : forwardUm;
+    while (_TravelUm >= 1000) {
+        _TravelUm -= 1000;
+        _TravelMm++;
+    }
+}
+
+void OdometryClass::PrintStats() {
+    Serial.printf("Odometry: x %d mm, y %d mm, heading %u deg\n", X(), Y(), HeadingDegrees());
+    Serial.printf("%u mm travelled, %u ticks stalled\n", _TravelMm, _StallTicks);
+}
+
+// private:
+// Sine of a binary angle, 1.0 = 16384, from the quarter table with a straight line between steps.
+int16_t OdometryClass::Sine(uint16_t const angle) {
+    uint8_t const quadrant = angle >> 14;
+    uint16_t position = angle & 0x3FFF;
+
+    // The second and fourth quarters run the table backwards.
+    if (quadrant & 1)
+        position = 0x4000 - position;
+
+    uint8_t const index = position >> 8;
+    uint8_t const fraction = position & 0xFF;
+    int16_t const low = pgm_read_word(&SineQuarter[index]);
+    int16_t const high = index < 64 ? pgm_read_word(&SineQuarter[index + 1]) : low;
+    int16_t const value = low + (((int32_t)(high - low) * fraction + 128) >> 8);
+
+    return quadrant & 2 ? -value : value;
+}
+
+// Odometry.cpp EOF
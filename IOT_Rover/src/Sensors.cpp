@@ -12,6 +12,11 @@
 #include <Blynk/BlynkTimer.h>
 #include "DeviceConfig.h"
 #include "Sensors.h"
+#include "Format.h"
+#include "AutoBright.h"
+#include "Mobility.h"
+#include "Odometry.h"
+#include "I2CBus.h"
 #include "VirtualPinDefs.h"
 
 //*****************************************************************************
@@ -53,16 +58,53 @@ uint16_t SensorsClass::RawLightLux;
 // #define Acc_Debug           1
 #define Acc_RunInerval      300
 TPedometer SensorsClass::_Pedometer;
-int SensorsClass::AccTID;
+int SensorsClass::AccTID = -1;
 uint32_t SensorsClass::StepCount;
 uint8_t SensorsClass::Orientation;
 
 // Time of Flight
 #define Tof_RunInerval      1000
 Distance SensorsClass::_TofSensor;
-int SensorsClass::_TofTID;
+int SensorsClass::_TofTID = -1;
 uint16_t SensorsClass::RawDistance;
 
+// Obstacle reflex, brake the motors when something is this close ahead.
+#define Tof_BrakeDistance   120     // mm, 0 turns the reflex off
+#define Tof_BrakeHysteresis 15      // mm either side, the VL53L0X reads a few mm of noise
+#define Tof_ReflexInerval   5       // Poll for each ranging while driving forwards
+uint16_t SensorsClass::_TofBrakeMm = Tof_BrakeDistance;
+bool SensorsClass::_TofForward = false;
+
+// Adaptive Sampling Rates
+// Raise the accelerometer and time of flight rates while the device is driving
+// or moving, back off to the slow rates once it has been idle for a while.
+// #define Rates_Debug         1   // Print every rate change
+#define Rates_RunInerval    250
+#define Rates_IdleHoldoff   3000    // Stay on the active rates this long after the last activity
+#define Rates_MotionLimit   48      // Accelerometer counts, ~0.05g at the 2g scale
+#define Acc_MinInerval      50      // Pedometer runs at a 50Hz output data rate
+#define Acc_MaxInerval      2000
+#define Tof_MinInerval      20      // The VL53L0X ranges back to back, ~20ms each
+#define Tof_MaxInerval      5000
+
+typedef struct {
+    uint16_t AccIdle;
+    uint16_t AccActive;
+    uint16_t TofIdle;
+    uint16_t TofActive;
+} Rates_Profile_t;
+
+// Indexed by DC_Rates.
+static const Rates_Profile_t RatesProfile[] = {
+    {Acc_RunInerval,    Acc_RunInerval,     Tof_RunInerval,     Tof_RunInerval},    // DC_Rates_Fixed
+    {1000,              150,                3000,               100},               // DC_Rates_Adaptive
+    {600,               50,                 2000,               40}                 // DC_Rates_AdaptiveFast
+};
+
+int SensorsClass::_RatesTID = -1;
+bool SensorsClass::_RatesActive = false;
+uint32_t SensorsClass::_RatesActiveMs = 0;
+
 //=============================================================================
 // Class Member Method Definitions (static)
 //-----------------------------------------------------------------------------
@@ -97,6 +139,7 @@ void SensorsClass::Init(EC_12S_t *const errorCodePtr) {
             Display.SetNumber(Display_PRIMARY_Show, GetBatteryVoltage()*10);
             Display.ManualWriteStringStart();
         }
+        I2CBus.Run();
     }
 
     // Waiting a period of time, do things within the wait period.
@@ -107,6 +150,7 @@ void SensorsClass::Init(EC_12S_t *const errorCodePtr) {
         if (DeviceConfig.getDisplay()) {
             Display.Invert();
             Display.WriteBuffer();
+            I2CBus.Run();
         }
 
         // Begin detecting the DHT sensor. 
@@ -178,33 +222,107 @@ void SensorsClass::Init(EC_12S_t *const errorCodePtr) {
     byte tofSuccess = false;
     if (_TofSensor.Init()) {
         tofSuccess = true;
-        TofRun();   // Run the accelerometer once, schedule for periodic run
+        SetTofBrake(_TofBrakeMm);
+        TofRun();   // Poll the distance sensor once, schedule for periodic run
         _TofTID = GlobalTimer.setInterval(Tof_RunInerval, TofRun);
+
+        // Sample fast while driving forwards, for the obstacle reflex.
+        Mobility.SubscribeForward(TofForward);
     }
     // Log an error if Distance.Init() failed
     ErrorCode_12SLog(errorCodePtr, tofSuccess == false);
+
+    // Let the accelerometer and time of flight rates follow the device activity
+    if (DeviceConfig.getRates() != DC_Rates_Fixed && (AccTID != -1 || _TofTID != -1)) {
+        ApplyRates();
+        _RatesTID = GlobalTimer.setInterval(Rates_RunInerval, RatesRun);
+    }
 }
 
 void SensorsClass::ShowOnDisplay(uint8_t const show, uint8_t const vpin) {
+    char text[16];
+    uint8_t length;
+    const char *units = "";
+
     if (vpin == Temperature_Vpin) {
-        Display.SetString(show, String(GetTemperature(),0) + char(176) + "C");
+        length = Format.Fixed(text, sizeof(text), 0, GetTemperature(), 0);
+        units = Format_DegreesC;
     } else if (vpin == Humidity_Vpin) {
-        Display.SetString(show, String(GetHumidity(),0) + char(37));
+        length = Format.Fixed(text, sizeof(text), 0, GetHumidity(), 0);
+        units = Format_Percent;
     } else if (vpin == HeatIndex_Vpin) {
-        Display.SetString(show, String(GetHeatIndex(),1) + char(176) + "C");
+        length = Format.Fixed(text, sizeof(text), 0, GetHeatIndex(), 1);
+        units = Format_DegreesC;
     } else if (vpin == DewPoint_Vpin) {
-        Display.SetString(show, String(GetDewPoint(),1) + char(176) + "C");
+        length = Format.Fixed(text, sizeof(text), 0, GetDewPoint(), 1);
+        units = Format_DegreesC;
     } else if (vpin == BatteryVoltage_Vpin) {
-        Display.SetString(show, String(GetBatteryVoltage(),1) + "V");
+        length = Format.Fixed(text, sizeof(text), 0, GetBatteryVoltage(), 1);
+        units = Format_Volts;
     } else if (vpin == LightLux_Vpin) {
-        Display.SetString(show, String(GetLightLux(),1) + "lx");
+        length = Format.Fixed(text, sizeof(text), 0, GetLightLux(), 1);
+        units = Format_Lux;
     } else if (vpin == StepCount_Vpin){
-        Display.SetNumber(show, StepCount);
+        length = Format.Unsigned(text, sizeof(text), 0, StepCount);
     } else if (vpin == Orientation_Vpin) {
-        Display.SetNumber(show, Orientation);
+        length = Format.Unsigned(text, sizeof(text), 0, Orientation);
     } else if (vpin == Distance_Vpin) {
-        Display.SetNumber(show, GetDistance());
+        length = Format.Unsigned(text, sizeof(text), 0, GetDistance());
+    } else {
+        return;
     }
+
+    Format.Text(text, sizeof(text), length, units);
+    Display.SetString(show, text);
+}
+
+// Display stream source, one reading of the next attached sensor each call.
+// Readings are taken as the scroll reaches them, not when the stream starts.
+uint8_t SensorsClass::SummarySource(char *const buffer, uint8_t const size) {
+    static uint8_t item = 0;
+
+    for (uint8_t tries = 0; tries < 6; tries++) {
+        uint8_t const current = item;
+        item = (item + 1) % 6;
+        uint8_t length;
+
+        switch (current) {
+            case 0:
+                if (_DhtTID == -1) continue;
+                length = Format.Fixed(buffer, size, 0, GetTemperature(), 1);
+                length = Format.Text(buffer, size, length, Format_DegreesC);
+                break;
+            case 1:
+                if (_DhtTID == -1) continue;
+                length = Format.Fixed(buffer, size, 0, GetHumidity(), 0);
+                length = Format.Text(buffer, size, length, Format_Percent);
+                break;
+            case 2:
+                if (DeviceConfig.getAnalog() != DC_Analog_Mux_Batt_Lux) continue;
+                length = Format.Fixed(buffer, size, 0, GetBatteryVoltage(), 1);
+                length = Format.Text(buffer, size, length, Format_Volts);
+                break;
+            case 3:
+                if (DeviceConfig.getAnalog() != DC_Analog_Mux_Batt_Lux) continue;
+                length = Format.Fixed(buffer, size, 0, GetLightLux(), 0);
+                length = Format.Text(buffer, size, length, Format_Lux);
+                break;
+            case 4:
+                if (AccTID == -1) continue;
+                length = Format.Unsigned(buffer, size, 0, StepCount);
+                length = Format.Text(buffer, size, length, Format_Steps);
+                break;
+            default:
+                if (_TofTID == -1) continue;
+                length = Format.Unsigned(buffer, size, 0, GetDistance());
+                length = Format.Text(buffer, size, length, Format_Millimetres);
+                break;
+        }
+
+        return Format.Text(buffer, size, length, "  ");
+    }
+
+    return 0;
 }
 
 void SensorsClass::DhtRun() {
@@ -324,6 +442,8 @@ void SensorsClass::AnalogRun() {
             ShowOnDisplayPrimary == LightLux_Vpin           ) {
                 ShowOnDisplay(Display_PRIMARY_Show, ShowOnDisplayPrimary);
         }
+
+        AutoBright.Update(GetLightLux());
     }
 
 #ifdef Analog_Debug
@@ -361,13 +481,32 @@ uint16_t SensorsClass::GetDistance() {
     return RawDistance;
 }
 
+void SensorsClass::SetTofBrake(uint16_t const distanceMm) {
+    _TofBrakeMm = distanceMm;
+
+    if (distanceMm) {
+        _TofSensor.SetThreshold(distanceMm, Tof_BrakeHysteresis);
+    } else {
+        (void)Mobility.SetObstacle(false);
+    }
+
+    if (_TofTID != -1)
+        ApplyRates();
+}
+
 void SensorsClass::AccRun() {    
     // Update pedometer
     _Pedometer.Update();
+    Odometry.SetMotion(_Pedometer.Motion);
+    bool const tapped = StepCount != _Pedometer.StepCount;
     StepCount = _Pedometer.StepCount;
     Orientation = _Pedometer.Rotation;
 
     if (DeviceConfig.getDisplay()) {
+        // A tap counts as a step, wake the display for it.
+        if (tapped)
+            Display.Wake();
+
         Display.UpdateRotation(Orientation);
         if (ShowOnDisplayPrimary == StepCount_Vpin      ||
             ShowOnDisplayPrimary == Orientation_Vpin    ) {
@@ -387,8 +526,18 @@ void SensorsClass::AccRun() {
 }
 
 void SensorsClass::TofRun() {
-    // Update distance reading
-    RawDistance = _TofSensor.GetDistance();
+    // Take the latest ranging if it is done, one ranging gives the distance and the threshold.
+    if (!_TofSensor.Poll())
+        return;
+
+    bool const ahead = _TofSensor.IsWithinThreshold();
+    RawDistance = _TofSensor.LastDistance();
+
+    // From when the ranging that saw it began to the brake command on the bus.
+    if (_TofBrakeMm && Mobility.SetObstacle(ahead)) {
+        Serial.printf("%lu ToF brake at %u mm, %lu us\n", millis(), RawDistance,
+                      (unsigned long)(micros() - _TofSensor.ReadingUs()));
+    }
     if (DeviceConfig.getDisplay()) {
         if (ShowOnDisplayPrimary == Distance_Vpin) {
             ShowOnDisplay(Display_PRIMARY_Show, ShowOnDisplayPrimary);
@@ -396,4 +545,56 @@ void SensorsClass::TofRun() {
     }
 }
 
+void SensorsClass::RatesRun() {
+    bool active = Mobility.IsDriving() || 
+                  (AccTID != -1 && _Pedometer.Motion > Rates_MotionLimit);
+
+    // Hold the active rates for a while, stops the rates bouncing at the end of a move.
+    if (active)
+        _RatesActiveMs = millis();
+    else if (millis() - _RatesActiveMs < Rates_IdleHoldoff)
+        active = true;
+
+    if (active != _RatesActive) {
+        _RatesActive = active;
+        ApplyRates();
+    }
+}
+
+void SensorsClass::ApplyRates() {
+    uint8_t profile = DeviceConfig.getRates();
+
+    if (profile >= sizeof(RatesProfile) / sizeof(RatesProfile[0]))
+        profile = DC_Rates_Fixed;
+
+    uint16_t accInerval = _RatesActive ? RatesProfile[profile].AccActive : RatesProfile[profile].AccIdle;
+    uint16_t tofInerval = _RatesActive ? RatesProfile[profile].TofActive : RatesProfile[profile].TofIdle;
+    accInerval = constrain(accInerval, Acc_MinInerval, Acc_MaxInerval);
+    tofInerval = constrain(tofInerval, Tof_MinInerval, Tof_MaxInerval);
+
+    if (_TofForward && _TofBrakeMm)
+        tofInerval = Tof_ReflexInerval;
+
+    if (AccTID != -1)
+        (void)GlobalTimer.changeInterval(AccTID, accInerval);
+
+    // Range back to back only while the reflex is armed, otherwise the sensor
+    // sleeps between the polls.
+    if (_TofTID != -1) {
+        _TofSensor.SetContinuous(_TofForward && _TofBrakeMm);
+        (void)GlobalTimer.changeInterval(_TofTID, tofInerval);
+    }
+
+#ifdef Rates_Debug
+    Serial.printf("%lu Rates %s: acc %u ms, tof %u ms\n", millis(), 
+                  _RatesActive ? "active" : "idle", accInerval, tofInerval);
+#endif
+}
+
+// Driving forwards started or ended.
+void SensorsClass::TofForward(bool const forward) {
+    _TofForward = forward;
+    ApplyRates();
+}
+
 // Sensors.cpp EOF
\ No newline at end of file
@@ -23,7 +23,7 @@ Distributed as-is; no warranty is given.
 
 #include "SparkFun_MMA8452Q.h"
 #include <Arduino.h>
-#include <Wire.h>
+#include "I2CBus.h"
 
 // CONSTRUCTUR
 //   This function, called when you initialize the class will simply write the
@@ -252,27 +252,22 @@ void MMA8452Q::writeRegister(MMA8452Q_Register reg, byte data)
 //	auto-incrmenting to the next.
 void MMA8452Q::writeRegisters(MMA8452Q_Register reg, byte *buffer, byte len)
 {
-	Wire.beginTransmission(address);
-	Wire.write(reg);
-	for (int x = 0; x < len; x++)
-		Wire.write(buffer[x]);
-	Wire.endTransmission(); //Stop transmitting
+	I2CBus_Trans_t trans;
+	I2CBus.Init(&trans, address, I2CBus_Burst, I2CBus_PriorityAccel);
+	trans.TxData[0] = reg;
+	trans.TxLen = 1;
+	trans.BurstPtr = buffer;
+	trans.BurstLen = len;
+	I2CBus.Transact(&trans); // Runs now, after any queued motor or distance traffic
 }
 
 // READ A SINGLE REGISTER
 //	Read a byte from the MMA8452Q register "reg".
 byte MMA8452Q::readRegister(MMA8452Q_Register reg)
 {
-	Wire.beginTransmission(address);
-	Wire.write(reg);
-	Wire.endTransmission(false); //endTransmission but keep the connection active
-
-	Wire.requestFrom(address, (byte) 1); //Ask for 1 byte, once done, bus is released by default
-
-	if (Wire.available()) // Wait for the data to come back
-		return Wire.read(); // Return this one byte
-	else
-		return 0;
+	byte data = 0;
+	readRegisters(reg, &data, 1);
+	return data; // 0 if the read failed
 }
 
 // READ MULTIPLE REGISTERS
@@ -280,14 +275,11 @@ byte MMA8452Q::readRegister(MMA8452Q_Register reg)
 //	in "buffer" on exit.
 void MMA8452Q::readRegisters(MMA8452Q_Register reg, byte *buffer, byte len)
 {
-	Wire.beginTransmission(address);
-	Wire.write(reg);
-	Wire.endTransmission(false); //endTransmission but keep the connection active
-
-	Wire.requestFrom(address, len); //Ask for bytes, once done, bus is released by default
-	if (Wire.available() == len)
-	{
-		for (int x = 0; x < len; x++)
-			buffer[x] = Wire.read();
-	}
+	I2CBus_Trans_t trans;
+	I2CBus.Init(&trans, address, I2CBus_WriteRead, I2CBus_PriorityAccel);
+	trans.TxData[0] = reg;
+	trans.TxLen = 1;
+	trans.RxPtr = buffer;
+	trans.RxLen = len;
+	I2CBus.Transact(&trans); // buffer is only written if all "len" bytes arrived
 }
@@ -0,0 +1,232 @@
+//////////////////////////////// UdpDrive.cpp /////////////////////////////////
+// Filename:	UdpDrive.cpp
+// Description: Drive the rover over UDP on the local network, not the cloud.
+// Author:		Danon Bradford
+// Date:		2020-05-23
+//////////////////////////////// UdpDrive.cpp /////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <Arduino.h>				// Arduino Header file
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include "DeviceConfig.h"			// DeviceConfig Header file
+#include "Display.h"				// Display Header file
+#include "Mobility.h"				// Mobility Header file
+#include "WiFiMgmt.h"				// WiFiMgmt Header file
+#include "UdpDrive.h"				// Source Header file
+
+//*****************************************************************************
+// Publicly Accessible Global Variable Definitions
+//-----------------------------------------------------------------------------
+UdpDriveClass UdpDrive;
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static WiFiUDP Udp;
+
+// Where the session's Hello came from, commands from anywhere else are dropped.
+static IPAddress SessionIp;
+static uint16_t SessionPort = 0;
+static IPAddress PendingIp;
+static uint16_t PendingPort = 0;
+
+//*****************************************************************************
+// Class Member Variable Definitions (static)
+//-----------------------------------------------------------------------------
+bool UdpDriveClass::_Listening = false;
+bool UdpDriveClass::_Session = false;
+uint32_t UdpDriveClass::_Token = 0;
+bool UdpDriveClass::_Pending = false;
+uint32_t UdpDriveClass::_PendingToken = 0;
+bool UdpDriveClass::_SeqValid = false;
+uint16_t UdpDriveClass::_Seq = 0;
+
+uint32_t UdpDriveClass::_Packets = 0;
+uint32_t UdpDriveClass::_Used = 0;
+uint32_t UdpDriveClass::_Reordered = 0;
+uint32_t UdpDriveClass::_Rejected = 0;
+uint32_t UdpDriveClass::_Sessions = 0;
+
+//=============================================================================
+// Class Member Method Definitions (static)
+//-----------------------------------------------------------------------------
+// public:
+// Listen whenever the station is connected.
+void UdpDriveClass::Begin() {
+    (void)WiFiMgmt.SubscribeStatus(Status);
+}
+
+// From loop(), a few packets at a time so that a flood can not hold it up.
+void UdpDriveClass::Run() {
+    if (!_Listening)
+        return;
+
+    for (uint8_t i = 0; i < UdpDrive_PacketsPerRun; i++) {
+        int const size = Udp.parsePacket();
+
+        if (size <= 0)
+            return;
+
+        uint8_t packet[UdpDrive_MaxPacket];
+        int const length = Udp.read(packet, sizeof(packet));
+        _Packets++;
+
+        if (size > (int)sizeof(packet) || length < 3 ||
+            packet[0] != UdpDrive_Magic0 || packet[1] != UdpDrive_Magic1) {
+            _Rejected++;
+            continue;
+        }
+
+        Handle(packet, length);
+    }
+}
+
+void UdpDriveClass::PrintStats() {
+    Serial.printf("UDP drive: %s, %u sessions, %u packets, %u used, %u out of order, %u rejected\n",
+                  _Listening ? (_Session ? "in session" : "listening") : "off",
+                  _Sessions, _Packets, _Used, _Reordered, _Rejected);
+}
+
+// private:
+void UdpDriveClass::Status(const bool connected) {
+    _Session = false;
+    _Pending = false;
+
+    if (connected && DeviceConfig.ValidBlynk) {
+        _Listening = Udp.begin(UdpDrive_Port) != 0;
+    } else if (_Listening) {
+        Udp.stop();
+        _Listening = false;
+    }
+}
+
+void UdpDriveClass::Handle(uint8_t const *const packet, uint8_t const length) {
+    if (packet[2] != UdpDrive_Hello) {
+        if (Command(packet, length))
+            Reply(UdpDrive_Ack, _Seq, 2);
+        return;
+    }
+
+    if (length != 7) {
+        _Rejected++;
+        return;
+    }
+
+    // The session in use carries on until the new one sends a good command.
+    uint32_t const clientNonce = (uint32_t)packet[3] << 24 | (uint32_t)packet[4] << 16 | packet[5] << 8 | packet[6];
+    uint32_t const roverNonce = RANDOM_REG32;
+
+    _PendingToken = Token(DeviceConfig.BlynkTokenNv, roverNonce, clientNonce);
+    _Pending = true;
+    PendingIp = Udp.remoteIP();
+    PendingPort = Udp.remotePort();
+
+    Reply(UdpDrive_Welcome, roverNonce, 4);
+}
+
+// The command is from the session in use, or is the first from a new one.
+bool UdpDriveClass::FromSession(uint32_t const token) {
+    uint32_t const ip = Udp.remoteIP();
+    uint16_t const port = Udp.remotePort();
+
+    if (_Session && token == _Token && ip == (uint32_t)SessionIp && port == SessionPort)
+        return true;
+
+    if (!_Pending || token != _PendingToken || ip != (uint32_t)PendingIp || port != PendingPort)
+        return false;
+
+    _Token = _PendingToken;
+    _Session = true;
+    _Pending = false;
+    _SeqValid = false;
+    _Sessions++;
+    SessionIp = PendingIp;
+    SessionPort = PendingPort;
+
+    Serial.printf("UDP drive session from %u.%u.%u.%u\n", SessionIp[0], SessionIp[1], SessionIp[2], SessionIp[3]);
+    return true;
+}
+
+//=============================================================================
+// UdpDrive::Command
+//
+// Check a command is from the session and newer than the last one, then use it.
+// Output:
+//	  bool - true if it was used, and is to be acknowledged.
+//-----------------------------------------------------------------------------
+bool UdpDriveClass::Command(uint8_t const *const packet, uint8_t const length) {
+    if (length < UdpDrive_CommandSize ||
+        !FromSession((uint32_t)packet[3] << 24 | (uint32_t)packet[4] << 16 | packet[5] << 8 | packet[6])) {
+        _Rejected++;
+        return false;
+    }
+
+    // Sequence numbers wrap, newer is up to half the range ahead.
+    uint16_t const seq = packet[7] << 8 | packet[8];
+    if (_SeqValid && (int16_t)(seq - _Seq) <= 0) {
+        _Reordered++;
+        return false;
+    }
+
+    bool used = false;
+
+    switch (packet[2]) {
+        case UdpDrive_Drive:
+            if (length != UdpDrive_CommandSize + 2)
+                break;
+            Mobility.SetDrive(constrain((int8_t)packet[9], -Mobility_InputMax, Mobility_InputMax),
+                              constrain((int8_t)packet[10], -Mobility_InputMax, Mobility_InputMax));
+            Display.Wake();
+            used = true;
+            break;
+
+        case UdpDrive_Text: {
+            uint8_t const count = length > UdpDrive_CommandSize ? packet[9] : 0;
+            if (count == 0 || count > UdpDrive_MaxText || length != UdpDrive_CommandSize + 1 + count)
+                break;
+
+            char text[UdpDrive_MaxText + 1];
+            memcpy(text, &packet[10], count);
+            text[count] = 0;
+            Display.SetString(Display_TEMPORARY_Show, text);
+            Display.SetMode(Display_TEMPORARY_Show, Display_String_Mode);
+            Display.ActivateTempShow(UdpDrive_TextMs);
+            used = true;
+            break;
+        }
+
+        case UdpDrive_Stop:
+            if (length != UdpDrive_CommandSize)
+                break;
+            Mobility.EmergencyStop();
+            used = true;
+            break;
+    }
+
+    if (!used) {
+        _Rejected++;
+        return false;
+    }
+
+    _Seq = seq;
+    _SeqValid = true;
+    _Used++;
+    return true;
+}
+
+// Welcome or Ack to the packet being handled, with a number high byte first.
+void UdpDriveClass::Reply(uint8_t const type, uint32_t const value, uint8_t const bytes) {
+    uint8_t packet[7] = {UdpDrive_Magic0, UdpDrive_Magic1, type};
+
+    for (uint8_t i = 0; i < bytes; i++)
+        packet[3 + i] = value >> (8 * (bytes - 1 - i));
+
+    Udp.beginPacket(Udp.remoteIP(), Udp.remotePort());
+    Udp.write(packet, 3 + bytes);
+    Udp.endPacket();
+}
+
+// UdpDrive.cpp EOF
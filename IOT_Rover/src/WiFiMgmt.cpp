@@ -13,8 +13,10 @@
 #include <ESP8266WiFi.h>
 #include <Blynk/BlynkTimer.h>   
 #include "Planque.h"
+#include "I2CBus.h"
 #include "Display.h"
 #include "DeviceConfig.h"
+#include "Mobility.h"
 #include "IDL_Version.h" 
 #include "WiFiMgmt.h"
 
@@ -186,6 +188,7 @@ void WiFiMgmtClass::EnterSoftAP() {
         _DnsServer.processNextRequest();
         _WebServer.handleClient();
         GlobalTimer.run();
+        I2CBus.Run();
         
         // let the background os run
         yield(); 
@@ -460,6 +463,16 @@ void WiFiMgmtClass::handleConfig() {
     item.replace("{l}", "8");
     item.replace("{v}", String(DeviceConfig.ProductConfigArrayNv[1], HEX));
     page += item;
+    page += "<br/><br/><br/>";
+
+    page += F("<dt>Display Panel Order</dt>");
+    item = FPSTR(HTTP_FORM_PARAM);
+    item.replace("{i}", "pc2");
+    item.replace("{n}", "pc2");
+    item.replace("{p}", "Hexadecimal number, 0 for address order");
+    item.replace("{l}", "8");
+    item.replace("{v}", String(DeviceConfig.ProductConfigArrayNv[2], HEX));
+    page += item;
 
     page += FPSTR(HTTP_FORM_END);
     page += FPSTR(HTTP_GO_BACK);
@@ -536,6 +549,10 @@ void WiFiMgmtClass::handleConfigSave() {
         page += F("<dt>The Product Config Code is empty... Please go back and enter the code!</dt>");
     }
 
+    if (_WebServer.arg("pc2") != "") {
+        writeNeeded |= Planque.NewU32(&DeviceConfig.ProductConfigArrayNv[2], strtoul(_WebServer.arg("pc2").c_str(), NULL, 16));
+    }
+
     if (writeNeeded) {
         Planque.WriteBufferToFlash();
     }
@@ -587,6 +604,42 @@ void WiFiMgmtClass::handleInfo() {
     // page += ESP.getVcc();
     // page += F("</dd>");
 
+    page += F("<dt>I2C Bus</dt><dd>");
+    page += I2CBus.ClockHz / 1000;
+    page += F(" kHz, ");
+    page += I2CBus.DutyPermille() / 10;
+    page += F(".");
+    page += I2CBus.DutyPermille() % 10;
+    page += F("% busy, ");
+    page += I2CBus.Dropped;
+    page += F(" dropped");
+    for (uint8_t i = 0; I2CBus.GetStats(i); i++) {
+        const I2CBus_Stats_t* stats = I2CBus.GetStats(i);
+        page += F("<br/>0x");
+        page += String(stats->Addr, HEX);
+        page += F(": ");
+        page += stats->Transactions;
+        page += F(" transactions, ");
+        page += stats->Bytes;
+        page += F(" bytes, ");
+        page += stats->Errors;
+        page += F(" errors, ");
+        page += stats->Nacks;
+        page += F(" nacks, ");
+        page += stats->BusyUs;
+        page += F(" us");
+    }
+    page += F("</dd>");
+
+    page += F("<dt>Motor Faults</dt><dd>");
+    for (uint8_t i = 0; i < Mobility_MotorCount; i++) {
+        char text[Mobility_FaultSummarySize];
+        (void)Mobility.FaultSummary(i, text, sizeof(text));
+        if (i) page += F("<br/>");
+        page += text;
+    }
+    page += F("</dd>");
+
     page += F("<dt>ESP8266 Free Heap</dt><dd>");
     page += ESP.getFreeHeap();
     page += F(" bytes</dd>");
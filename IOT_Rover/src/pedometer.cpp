@@ -19,6 +19,7 @@ TPedometer::TPedometer() : MMA8452Q(ACCEL_ADDRESS)
   OldY = 0;
   OldZ = 0;
   OldRotation = LOCKOUT;
+  Motion = 0;
 }
 
 uint8_t TPedometer::Init()
@@ -65,9 +66,13 @@ void TPedometer::Update()
     OldZ = z;
     read();
     XYZHasChanged = (OldX != x) || (OldY != y) || (OldZ != z);
+    Motion = abs(x - OldX) + abs(y - OldY) + abs(z - OldZ);
   }
   else
+  {
     XYZHasChanged = false;
+    Motion = 0;
+  }
     
 	// Check the accelerometer for a tap
 	if (readTap() != 0)
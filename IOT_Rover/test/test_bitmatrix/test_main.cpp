@@ -0,0 +1,144 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: BitMatrix against a bit at a time reference.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include "BitMatrix.h"				// BitMatrix Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Images      2000
+
+//*****************************************************************************
+// Private Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+// Where bit (row, col) ends up.
+typedef void (*Move_t)(uint8_t *const row, uint8_t *const col);
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static uint64_t Random() {
+    uint64_t x = 0;
+
+    for (uint8_t i = 0; i < 4; i++)
+        x = x << 16 | (rand() & 0xFFFF);
+
+    return x;
+}
+
+static uint64_t Reference(uint64_t const x, Move_t const move) {
+    uint64_t y = 0;
+
+    for (uint8_t row = 0; row < 8; row++) {
+        for (uint8_t col = 0; col < 8; col++) {
+            if (x >> (row * 8 + col) & 1) {
+                uint8_t r = row, c = col;
+                move(&r, &c);
+                y |= 1ull << (r * 8 + c);
+            }
+        }
+    }
+
+    return y;
+}
+
+static void Transposed(uint8_t *const row, uint8_t *const col) {
+    uint8_t const r = *row; *row = *col; *col = r;
+}
+
+static void RowsFlipped(uint8_t *const row, uint8_t *const col) {
+    (void)col; *row = 7 - *row;
+}
+
+static void ColumnsFlipped(uint8_t *const row, uint8_t *const col) {
+    (void)row; *col = 7 - *col;
+}
+
+static void Rotated90(uint8_t *const row, uint8_t *const col) {
+    uint8_t const r = *row; *row = *col; *col = 7 - r;
+}
+
+static void Rotated180(uint8_t *const row, uint8_t *const col) {
+    *row = 7 - *row; *col = 7 - *col;
+}
+
+static void Rotated270(uint8_t *const row, uint8_t *const col) {
+    uint8_t const r = *row; *row = 7 - *col; *col = r;
+}
+
+static void Check(uint64_t (*const kernel)(uint64_t), Move_t const move) {
+    // Every single bit, then random images.
+    for (uint8_t bit = 0; bit < 64; bit++)
+        TEST_ASSERT_EQUAL_HEX64(Reference(1ull << bit, move), kernel(1ull << bit));
+
+    srand(32);
+    for (uint16_t i = 0; i < Images; i++) {
+        uint64_t const x = Random();
+        TEST_ASSERT_EQUAL_HEX64(Reference(x, move), kernel(x));
+    }
+}
+
+//=============================================================================
+// Tests
+//-----------------------------------------------------------------------------
+void test_transpose() {
+    Check(BitMatrix::Transpose, Transposed);
+}
+
+void test_flip_rows() {
+    Check(BitMatrix::FlipRows, RowsFlipped);
+}
+
+void test_flip_columns() {
+    Check(BitMatrix::FlipColumns, ColumnsFlipped);
+}
+
+void test_rotate_90() {
+    Check(BitMatrix::Rotate90, Rotated90);
+}
+
+void test_rotate_180() {
+    Check(BitMatrix::Rotate180, Rotated180);
+}
+
+void test_rotate_270() {
+    Check(BitMatrix::Rotate270, Rotated270);
+}
+
+void test_four_turns_come_back() {
+    srand(33);
+    for (uint16_t i = 0; i < Images; i++) {
+        uint64_t const x = Random();
+        TEST_ASSERT_EQUAL_HEX64(x, BitMatrix::Rotate90(BitMatrix::Rotate90(BitMatrix::Rotate90(BitMatrix::Rotate90(x)))));
+        TEST_ASSERT_EQUAL_HEX64(x, BitMatrix::Rotate270(BitMatrix::Rotate90(x)));
+        TEST_ASSERT_EQUAL_HEX64(x, BitMatrix::Transpose(BitMatrix::Transpose(x)));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_transpose);
+    RUN_TEST(test_flip_rows);
+    RUN_TEST(test_flip_columns);
+    RUN_TEST(test_rotate_90);
+    RUN_TEST(test_rotate_180);
+    RUN_TEST(test_rotate_270);
+    RUN_TEST(test_four_turns_come_back);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,274 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: DriveScript timing, checks, and giving way to the app.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "DRV8830.h"				// DRV8830 Header file
+#include "DriveScript.h"			// DriveScript Header file
+#include "Mobility.h"				// Mobility Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Right       DRV8830_Addr0
+#define Left        DRV8830_Addr2
+#define VsetMin     6
+#define MaxEvents   64
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// Forward for 1.5 s, spin for 600 ms, brake for 200 ms, ten times over.
+static const char Dance[] = "05 0A  01 50 00  03 05DC  01 00 64  03 0258  02  03 00C8  06  00";
+#define DanceMs     2300
+
+// When forward driving started and stopped, from the Mobility subscription.
+static uint32_t Events[MaxEvents];
+static bool EventForward[MaxEvents];
+static uint8_t EventCount;
+
+static uint8_t LoopGapMs = 0;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static void Forward(bool const forward) {
+    if (EventCount < MaxEvents) {
+        Events[EventCount] = millis();
+        EventForward[EventCount++] = forward;
+    }
+}
+
+// loop() with other work that takes up to LoopGapMs, so timers run late.
+static void Loop() {
+    if (LoopGapMs)
+        delay(rand() % (LoopGapMs + 1));
+}
+
+static int8_t Output(uint8_t const addr) {
+    uint8_t const control = Host.Registers[addr][DRV8830_Control];
+    int8_t const vset = (control >> 2) - VsetMin;
+
+    switch (control & 0x03) {
+        case DRV8830_Forward: return vset;
+        case DRV8830_Reverse: return -vset;
+        default: return 0;
+    }
+}
+
+static uint8_t Bridge(uint8_t const addr) {
+    return Host.Registers[addr][DRV8830_Control] & 0x03;
+}
+
+// Ms until the script ends.
+static uint32_t UntilEnd() {
+    uint32_t const startMs = millis();
+
+    while (DriveScript.IsRunning() && millis() - startMs < 600000)
+        Host.Run(1);
+
+    return millis() - startMs;
+}
+
+// Begin sets the control loop timer, so it is only called once. Each test
+// starts with the rover at rest, no ramps and the deadman off so a manual
+// setpoint can be held.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Mobility.Begin();
+        Mobility.SubscribeForward(Forward);
+        started = true;
+    }
+
+    DriveScript.Stop();
+    Host.SetLoop(Loop);
+    LoopGapMs = 0;
+    Mobility.SetObstacle(false);
+    Mobility.SetDeadman(0, false);
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(0, 0);
+    Host.Run(100);
+    EventCount = 0;
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// Timing
+//-----------------------------------------------------------------------------
+void test_waits_are_kept_to_the_ms() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    uint32_t const startMs = millis();
+    DriveScript.Start();
+
+    TEST_ASSERT_EQUAL(10 * DanceMs, UntilEnd());
+    TEST_ASSERT_EQUAL(DriveScript_Finished, DriveScript.State());
+
+    // Forward at the start of each pass, the spin 1.5 s in.
+    TEST_ASSERT_EQUAL(20, EventCount);
+    for (uint8_t i = 0; i < EventCount; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 0, EventForward[i]);
+        TEST_ASSERT_EQUAL((i / 2) * DanceMs + (i % 2) * 1500, Events[i] - startMs);
+    }
+
+    Host.Run(Mobility_ControlPeriodMs);
+    TEST_ASSERT_EQUAL(0, Output(Right));
+    TEST_ASSERT_EQUAL(0, Output(Left));
+}
+
+void test_late_timers_do_not_add_up() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    srand(48);
+    LoopGapMs = 8;
+    uint32_t const startMs = millis();
+    DriveScript.Start();
+
+    uint32_t const ms = UntilEnd();
+    TEST_ASSERT_INT_WITHIN(LoopGapMs, 10 * DanceMs + LoopGapMs / 2, ms);
+
+    // Each step is late by at most one loop() pass, never by the sum of them.
+    TEST_ASSERT_EQUAL(20, EventCount);
+    for (uint8_t i = 0; i < EventCount; i++) {
+        uint32_t const plannedMs = (i / 2) * DanceMs + (i % 2) * 1500;
+        TEST_ASSERT_GREATER_OR_EQUAL(plannedMs, Events[i] - startMs);
+        TEST_ASSERT_LESS_OR_EQUAL(plannedMs + LoopGapMs + 1, Events[i] - startMs);
+    }
+}
+
+void test_nested_loops_run_their_counts() {
+    // 3 x (2 x 10 ms).
+    TEST_ASSERT_TRUE(DriveScript.Load("05 03 05 02 03 000A 06 06"));
+    DriveScript.Start();
+    TEST_ASSERT_EQUAL(60, UntilEnd());
+}
+
+void test_text_step_does_not_hold_up_the_script() {
+    TEST_ASSERT_TRUE(DriveScript.Load("03 0064 04 05 48656c6c6f 03 0064"));
+    DriveScript.Start();
+    TEST_ASSERT_EQUAL(200, UntilEnd());
+    TEST_ASSERT_EQUAL(DriveScript_Finished, DriveScript.State());
+}
+
+//=============================================================================
+// Giving way
+//-----------------------------------------------------------------------------
+void test_manual_setpoint_takes_over() {
+    uint8_t const timers = GlobalTimer.getNumTimers();
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    DriveScript.Start();
+    Host.Run(700);
+    TEST_ASSERT_EQUAL(46, Output(Right));
+
+    Mobility.SetDrive(30, -20);
+    TEST_ASSERT_EQUAL(DriveScript_Overridden, DriveScript.State());
+    TEST_ASSERT_EQUAL(timers, GlobalTimer.getNumTimers());
+
+    // The script's next steps never come.
+    Host.Run(3000);
+    TEST_ASSERT_EQUAL(29, Output(Right));
+    TEST_ASSERT_EQUAL(6, Output(Left));
+}
+
+void test_emergency_stop_takes_over() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    DriveScript.Start();
+    Host.Run(1600);
+
+    Mobility.EmergencyStop();
+    TEST_ASSERT_EQUAL(DriveScript_Overridden, DriveScript.State());
+    Host.Run(3000);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Left));
+}
+
+void test_obstacle_leaves_the_rover_braked() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    DriveScript.Start();
+    Host.Run(1000);
+
+    TEST_ASSERT_TRUE(Mobility.SetObstacle(true));
+    TEST_ASSERT_EQUAL(DriveScript_Obstacle, DriveScript.State());
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+
+    // The way clears, it does not drive on by itself.
+    Host.Run(500);
+    Mobility.SetObstacle(false);
+    Host.Run(2000);
+    TEST_ASSERT_EQUAL(0, Output(Right));
+    TEST_ASSERT_EQUAL(0, Output(Left));
+}
+
+void test_blocked_before_the_first_step() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    Mobility.SetObstacle(true);
+    DriveScript.Start();
+    TEST_ASSERT_EQUAL(DriveScript_Obstacle, DriveScript.State());
+}
+
+void test_no_wait_is_stopped() {
+    TEST_ASSERT_TRUE(DriveScript.Load("05 00 01 10 00 06"));
+    DriveScript.Start();
+    TEST_ASSERT_EQUAL(DriveScript_Runaway, DriveScript.State());
+    Host.Run(Mobility_ControlPeriodMs);
+    TEST_ASSERT_EQUAL(0, Output(Right));
+}
+
+//=============================================================================
+// Loading
+//-----------------------------------------------------------------------------
+void test_load_replaces_a_running_script() {
+    TEST_ASSERT_TRUE(DriveScript.Load(Dance));
+    DriveScript.Start();
+    Host.Run(100);
+
+    TEST_ASSERT_TRUE(DriveScript.Load("01 00 00"));
+    TEST_ASSERT_EQUAL(DriveScript_Cancelled, DriveScript.State());
+}
+
+void test_bad_scripts_keep_the_old_one() {
+    static const char *const bad[] = {
+        "", "0", "01 65 00", "01 00 9B", "01 00", "03 0000", "06", "05 01", "04 00",
+        "04 05 4142", "04 15 000000000000000000000000000000000000000000", "07",
+        "05 01 05 01 05 01 05 01 05 01 06 06 06 06 06", "zz", "01 10 00 0"
+    };
+
+    // Reverse and full right, the right wheel only.
+    TEST_ASSERT_TRUE(DriveScript.Load("01 9C 64 03 03E8"));
+
+    for (uint8_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+        TEST_ASSERT_FALSE_MESSAGE(DriveScript.Load(bad[i]), bad[i]);
+
+    DriveScript.Start();
+    Host.Run(2 * Mobility_ControlPeriodMs);
+    TEST_ASSERT_EQUAL(-DRV8830_MaxSpeed, Output(Right));
+    TEST_ASSERT_EQUAL(0, Output(Left));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_waits_are_kept_to_the_ms);
+    RUN_TEST(test_late_timers_do_not_add_up);
+    RUN_TEST(test_nested_loops_run_their_counts);
+    RUN_TEST(test_text_step_does_not_hold_up_the_script);
+    RUN_TEST(test_manual_setpoint_takes_over);
+    RUN_TEST(test_emergency_stop_takes_over);
+    RUN_TEST(test_obstacle_leaves_the_rover_braked);
+    RUN_TEST(test_blocked_before_the_first_step);
+    RUN_TEST(test_no_wait_is_stopped);
+    RUN_TEST(test_load_replaces_a_running_script);
+    RUN_TEST(test_bad_scripts_keep_the_old_one);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
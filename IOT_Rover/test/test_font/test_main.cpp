@@ -0,0 +1,141 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Font glyph cache hits, misses and eviction order.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "FontData.h"				// Font tables
+#include "Font.h"					// Font Header file
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static uint32_t Hits;
+static uint32_t Misses;
+
+// Each glyph as loaded straight after a miss, by code.
+static uint64_t Fresh[256];
+static uint8_t FreshWidth[256];
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+void setUp() {
+    Hits = Font.CacheHits;
+    Misses = Font.CacheMisses;
+}
+
+void tearDown() {
+}
+
+static uint64_t Show(uint8_t const code) {
+    uint8_t width;
+    return Font.Image(code, true, &width);
+}
+
+// Fill the cache with glyphs nothing else uses, in order.
+static void Fill(uint8_t const first) {
+    for (uint8_t i = 0; i < Font_CacheSize; i++)
+        Show(first + i);
+}
+
+//=============================================================================
+// Tests
+//-----------------------------------------------------------------------------
+void test_second_lookup_hits() {
+    Fill('a');
+    Show('A');
+    TEST_ASSERT_EQUAL(Misses + Font_CacheSize + 1, Font.CacheMisses);
+
+    Show('A');
+    Show('A');
+    TEST_ASSERT_EQUAL(Hits + 2, Font.CacheHits);
+}
+
+void test_least_recently_used_goes_first() {
+    Fill('a');
+
+    // 'a' is used again, so 'b' is now the oldest and goes for 'z'.
+    Show('a');
+    Show('z');
+    uint32_t const misses = Font.CacheMisses;
+
+    Show('a');
+    TEST_ASSERT_EQUAL(misses, Font.CacheMisses);
+    Show('c');
+    TEST_ASSERT_EQUAL(misses, Font.CacheMisses);
+    Show('b');
+    TEST_ASSERT_EQUAL(misses + 1, Font.CacheMisses);
+}
+
+void test_cache_holds_its_size() {
+    Fill('A');
+    uint32_t const misses = Font.CacheMisses;
+
+    for (uint8_t i = Font_CacheSize; i > 0; i--)
+        Show('A' + i - 1);
+    TEST_ASSERT_EQUAL(misses, Font.CacheMisses);
+
+    // One more than fits, in a cycle, misses every time.
+    for (uint8_t pass = 0; pass < 3; pass++) {
+        for (uint8_t i = 0; i <= Font_CacheSize; i++)
+            Show('0' + i);
+    }
+    TEST_ASSERT_EQUAL(misses + 3 * (Font_CacheSize + 1), Font.CacheMisses);
+}
+
+void test_hit_gives_the_same_glyph_as_a_miss() {
+    for (uint16_t code = 0; code < 256; code++) {
+        Fill(0xE0);
+        Fresh[code] = Font.Image(code, true, &FreshWidth[code]);
+    }
+
+    // Random order, so glyphs come from every place in the cache.
+    srand(35);
+    for (uint16_t i = 0; i < 4000; i++) {
+        uint8_t const code = ' ' + rand() % 20;
+        uint8_t width;
+        TEST_ASSERT_EQUAL_HEX64(Fresh[code], Font.Image(code, true, &width));
+        TEST_ASSERT_EQUAL(FreshWidth[code], width);
+    }
+}
+
+void test_glyphs_fit_the_cell() {
+    for (uint16_t code = 0; code < 256; code++) {
+        uint8_t width;
+        uint64_t const image = Font.Image(code, false, &width);
+
+        TEST_ASSERT_LESS_OR_EQUAL(8, width);
+        if (width == 0) {
+            TEST_ASSERT_EQUAL_HEX64(0, image);
+            continue;
+        }
+
+        // Against column 0, nothing past the width.
+        for (uint8_t row = 0; row < 8; row++)
+            TEST_ASSERT_EQUAL_HEX8(0, (uint8_t)(image >> (row * 8)) >> width);
+    }
+
+    uint8_t width;
+    TEST_ASSERT_TRUE(Font.Image('A', false, &width) != 0);
+    TEST_ASSERT_EQUAL(0, (Font.Image(' ', false, &width), width));
+    TEST_ASSERT_EQUAL(Font_SpaceAdvance, Font.Advance(' ', 'A'));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_second_lookup_hits);
+    RUN_TEST(test_least_recently_used_goes_first);
+    RUN_TEST(test_cache_holds_its_size);
+    RUN_TEST(test_hit_gives_the_same_glyph_as_a_miss);
+    RUN_TEST(test_glyphs_fit_the_cell);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,232 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: I2CBus queue order, and LightGrid commands queued with frames.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "I2CBus.h"					// I2CBus Header file
+#include "LightGrid.h"				// LightGrid Header file
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static I2CBus_Trans_t Trans[I2CBus_QueueDepth + 1];
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static void Prepare(I2CBus_Trans_t *const trans, uint8_t const addr, I2CBus_Priority const priority, uint8_t const data) {
+    I2CBus.Init(trans, addr, I2CBus_Write, priority);
+    trans->TxData[0] = data;
+    trans->TxLen = 1;
+}
+
+void setUp() {
+    I2CBus.Run();
+    Host.Reset();
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// I2CBus
+//-----------------------------------------------------------------------------
+void test_more_urgent_runs_first() {
+    Prepare(&Trans[0], 0x70, I2CBus_PriorityDisplay, 1);
+    Prepare(&Trans[1], 0x1D, I2CBus_PriorityAccel, 2);
+    Prepare(&Trans[2], 0x60, I2CBus_PriorityMotor, 3);
+    Prepare(&Trans[3], 0x29, I2CBus_PriorityTof, 4);
+
+    for (uint8_t i = 0; i < 4; i++)
+        TEST_ASSERT_TRUE(I2CBus.Submit(&Trans[i]));
+
+    TEST_ASSERT_EQUAL(4, I2CBus.Pending());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(0, I2CBus.Pending());
+    TEST_ASSERT_EQUAL(4, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x60, Host.I2CLog[0].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x29, Host.I2CLog[1].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x1D, Host.I2CLog[2].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x70, Host.I2CLog[3].Addr);
+}
+
+void test_same_priority_in_submit_order() {
+    for (uint8_t i = 0; i < I2CBus_QueueDepth; i++) {
+        Prepare(&Trans[i], 0x70, I2CBus_PriorityDisplay, i);
+        TEST_ASSERT_TRUE(I2CBus.Submit(&Trans[i]));
+    }
+
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(I2CBus_QueueDepth, Host.I2CCount);
+    for (uint8_t i = 0; i < I2CBus_QueueDepth; i++) {
+        TEST_ASSERT_EQUAL(I2CBus_Ok, Trans[i].Status);
+        TEST_ASSERT_EQUAL(i, Host.I2CLog[i].Data[0]);
+    }
+}
+
+void test_resubmit_while_pending_sends_once_with_latest() {
+    Prepare(&Trans[0], 0x70, I2CBus_PriorityDisplay, 0x11);
+    TEST_ASSERT_TRUE(I2CBus.Submit(&Trans[0]));
+    Trans[0].TxData[0] = 0x22;
+    TEST_ASSERT_TRUE(I2CBus.Submit(&Trans[0]));
+
+    TEST_ASSERT_EQUAL(1, I2CBus.Pending());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(1, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x22, Host.I2CLog[0].Data[0]);
+}
+
+void test_full_queue_drops_and_counts() {
+    uint32_t const dropped = I2CBus.Dropped;
+
+    for (uint8_t i = 0; i < I2CBus_QueueDepth; i++) {
+        Prepare(&Trans[i], 0x70, I2CBus_PriorityDisplay, i);
+        TEST_ASSERT_TRUE(I2CBus.Submit(&Trans[i]));
+    }
+
+    TEST_ASSERT_EQUAL(0, I2CBus.Room(I2CBus_PriorityDisplay));
+    TEST_ASSERT_EQUAL(I2CBus_QueueDepth, I2CBus.Room(I2CBus_PriorityMotor));
+
+    Prepare(&Trans[I2CBus_QueueDepth], 0x70, I2CBus_PriorityDisplay, 0xFF);
+    TEST_ASSERT_FALSE(I2CBus.Submit(&Trans[I2CBus_QueueDepth]));
+    TEST_ASSERT_EQUAL(dropped + 1, I2CBus.Dropped);
+    TEST_ASSERT_EQUAL(I2CBus_Idle, Trans[I2CBus_QueueDepth].Status);
+}
+
+void test_transact_flushes_only_more_urgent() {
+    Prepare(&Trans[0], 0x70, I2CBus_PriorityDisplay, 1);
+    Prepare(&Trans[1], 0x60, I2CBus_PriorityMotor, 2);
+    Prepare(&Trans[2], 0x29, I2CBus_PriorityTof, 3);
+    I2CBus.Submit(&Trans[0]);
+    I2CBus.Submit(&Trans[1]);
+
+    TEST_ASSERT_TRUE(I2CBus.Transact(&Trans[2]));
+
+    TEST_ASSERT_EQUAL(2, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x60, Host.I2CLog[0].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x29, Host.I2CLog[1].Addr);
+    TEST_ASSERT_EQUAL(I2CBus_Pending, Trans[0].Status);
+}
+
+void test_write_read_and_nack() {
+    uint8_t rx[2] = {0};
+    Host.Registers[0x60][0x01] = 0x81;
+    Host.Registers[0x60][0x02] = 0x42;
+
+    I2CBus.Init(&Trans[0], 0x60, I2CBus_WriteRead, I2CBus_PriorityMotor);
+    Trans[0].TxData[0] = 0x01;
+    Trans[0].TxLen = 1;
+    Trans[0].RxPtr = rx;
+    Trans[0].RxLen = 2;
+
+    TEST_ASSERT_TRUE(I2CBus.Transact(&Trans[0]));
+    TEST_ASSERT_EQUAL_HEX8(0x81, rx[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x42, rx[1]);
+
+    Host.Nack[0x60] = true;
+    TEST_ASSERT_FALSE(I2CBus.Transact(&Trans[0]));
+    TEST_ASSERT_EQUAL(I2CBus_NackAddr, Trans[0].Status);
+}
+
+void test_duty_is_of_the_last_window() {
+    // Line up with a window, then 250 ms of bus time in it.
+    Host.Run(3 * I2CBus_ProfileWindow);
+    (void)I2CBus.DutyPermille();
+    I2CBus.Account(0x29, 250000, true);
+    TEST_ASSERT_EQUAL(0, I2CBus.DutyPermille());
+
+    Host.Run(I2CBus_ProfileWindow);
+    TEST_ASSERT_EQUAL(250, I2CBus.DutyPermille());
+
+    // A quiet bus reads idle once a whole window has gone by.
+    Host.Run(I2CBus_ProfileWindow);
+    TEST_ASSERT_EQUAL(0, I2CBus.DutyPermille());
+
+    // Busy time before a long gap is not spread over the gap.
+    I2CBus.Account(0x29, 500000, true);
+    Host.Run(5 * I2CBus_ProfileWindow);
+    I2CBus.Account(0x29, 100, true);
+    TEST_ASSERT_EQUAL(0, I2CBus.DutyPermille());
+}
+
+//=============================================================================
+// LightGrid commands
+//-----------------------------------------------------------------------------
+void test_command_waits_behind_frame() {
+    LightGrid::SetPanels(1, LightGrid_NaturalOrder);
+    LightGrid::Init();
+    LightGrid::ClearBuffer();
+    LightGrid::SetPixel(0, 0, 0, 1);
+
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    TEST_ASSERT_TRUE(LightGrid::Brightness(5));
+    TEST_ASSERT_EQUAL(0, Host.I2CCount);
+
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(2, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x00, Host.I2CLog[0].Data[0]);
+    TEST_ASSERT_EQUAL(17, Host.I2CLog[0].Length);
+    TEST_ASSERT_EQUAL_HEX8(0xE5, Host.I2CLog[1].Data[0]);
+    TEST_ASSERT_EQUAL(1, Host.I2CLog[1].Length);
+}
+
+void test_commands_keep_order_past_the_slots() {
+    uint8_t const commands = LightGrid_CommandDepth * 2 + 1;
+
+    LightGrid::SetPanels(2, LightGrid_NaturalOrder);
+    LightGrid::Init();
+
+    for (uint8_t i = 0; i < commands; i++)
+        TEST_ASSERT_TRUE(LightGrid::Brightness(i));
+
+    I2CBus.Run();
+
+    // Each command goes to both panels, none is lost or sent out of turn.
+    TEST_ASSERT_EQUAL(commands * 2, Host.I2CCount);
+    for (uint8_t i = 0; i < commands; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0x70, Host.I2CLog[i * 2].Addr);
+        TEST_ASSERT_EQUAL_HEX8(0x71, Host.I2CLog[i * 2 + 1].Addr);
+        TEST_ASSERT_EQUAL_HEX8(0xE0 | (i & 0x0F), Host.I2CLog[i * 2].Data[0]);
+        TEST_ASSERT_EQUAL_HEX8(0xE0 | (i & 0x0F), Host.I2CLog[i * 2 + 1].Data[0]);
+    }
+}
+
+void test_command_failure_is_counted() {
+    LightGrid::SetPanels(2, LightGrid_NaturalOrder);
+    LightGrid::Init();
+    uint32_t const errors = LightGrid::CommandErrors;
+
+    Host.Nack[0x71] = true;
+    TEST_ASSERT_TRUE(LightGrid::Display(1));
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(errors + 1, LightGrid::CommandErrors);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_more_urgent_runs_first);
+    RUN_TEST(test_same_priority_in_submit_order);
+    RUN_TEST(test_resubmit_while_pending_sends_once_with_latest);
+    RUN_TEST(test_full_queue_drops_and_counts);
+    RUN_TEST(test_transact_flushes_only_more_urgent);
+    RUN_TEST(test_write_read_and_nack);
+    RUN_TEST(test_duty_is_of_the_last_window);
+    RUN_TEST(test_command_waits_behind_frame);
+    RUN_TEST(test_commands_keep_order_past_the_slots);
+    RUN_TEST(test_command_failure_is_counted);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,334 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: LightGrid frames, the wiring and the changed RAM bytes.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "Display.h"				// Display Header file
+#include "I2CBus.h"					// I2CBus Header file
+#include "LightGrid.h"				// LightGrid Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define FullFrame       17          // The RAM address and all 16 RAM bytes
+#define ScrollMs        50          // Display's default scroll interval
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// How the board is wired, the HT16K33 row of each grid row, and the RAM
+// column of each grid column.
+static const uint8_t RowWire[12] = {7, 6, 3, 2, 0, 1, 4, 5, 8, 11, 10, 9};
+static const uint8_t ColumnWire[8] = {2, 1, 3, 4, 5, 6, 7, 0};
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+// A fresh single panel grid, with its first full frame already sent.
+void setUp() {
+    I2CBus.Run();
+    Host.Reset();
+    LightGrid::SetPanels(1, LightGrid_NaturalOrder);
+    LightGrid::Init();
+    LightGrid::ClearBuffer();
+    LightGrid::WriteBuffer();
+    I2CBus.Run();
+    Host.ClearI2CLog();
+}
+
+void tearDown() {
+}
+
+// The RAM image a grid should give, one pixel at a time from the wiring.
+static void Reference(bool const pixels[8][12], uint8_t ram[16]) {
+    memset(ram, 0, 16);
+
+    for (uint8_t x = 0; x < 8; x++) {
+        for (uint8_t y = 0; y < 12; y++) {
+            if (pixels[x][y])
+                ram[ColumnWire[x] * 2 + RowWire[y] / 8] |= 1 << (RowWire[y] % 8);
+        }
+    }
+}
+
+static void Send() {
+    LightGrid::WriteBuffer();
+    I2CBus.Run();
+}
+
+// Init sets the scroll timer, so it is only called once.
+static void StartDisplay() {
+    static bool started = false;
+
+    if (!started)
+        TEST_ASSERT_TRUE(Display.Init());
+    started = true;
+    I2CBus.Run();
+    Host.ClearI2CLog();
+}
+
+// Bytes sent to the panel since the log was cleared.
+static uint32_t PanelBytes() {
+    uint32_t bytes = 0;
+
+    for (uint16_t i = 0; i < Host.I2CCount; i++) {
+        if (Host.I2CLog[i].Addr == 0x70)
+            bytes += Host.I2CLog[i].Length;
+    }
+
+    return bytes;
+}
+
+//=============================================================================
+// Dirty ranges
+//-----------------------------------------------------------------------------
+void test_first_frame_is_whole() {
+    LightGrid::Init();
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(1, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x00, Host.I2CLog[0].Data[0]);
+    TEST_ASSERT_EQUAL(17, Host.I2CLog[0].Length);
+}
+
+void test_unchanged_frame_is_skipped() {
+    uint32_t const skipped = LightGrid::FramesSkipped;
+
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(0, Host.I2CCount);
+    TEST_ASSERT_EQUAL(skipped + 1, LightGrid::FramesSkipped);
+}
+
+void test_one_column_sends_its_bytes() {
+    // Column 0 is wired to RAM column 2, rows 0 to 7 are in its first byte.
+    LightGrid::SetPixel(0, 0, 0, 1);
+    LightGrid::WriteBuffer();
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(1, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x04, Host.I2CLog[0].Data[0]);
+    TEST_ASSERT_EQUAL(2, Host.I2CLog[0].Length);
+    TEST_ASSERT_EQUAL_HEX8(0x80, Host.Registers[0x70][0x04]);
+}
+
+void test_pending_frame_widens_to_both_changes() {
+    LightGrid::SetPixel(0, 0, 0, 1);
+    LightGrid::WriteBuffer();
+    LightGrid::SetPixel(0, 7, 8, 1);
+    LightGrid::WriteBuffer();
+
+    TEST_ASSERT_EQUAL(1, I2CBus.Pending());
+    I2CBus.Run();
+
+    // The high byte of RAM column 0 to the low byte of column 2, in one burst.
+    TEST_ASSERT_EQUAL(1, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x01, Host.I2CLog[0].Data[0]);
+    TEST_ASSERT_EQUAL(5, Host.I2CLog[0].Length);
+    TEST_ASSERT_EQUAL_HEX8(0x80, Host.Registers[0x70][0x04]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, Host.Registers[0x70][0x01]);
+}
+
+void test_failed_frame_resends_whole() {
+    Host.Nack[0x70] = true;
+    LightGrid::SetPixel(0, 3, 3, 1);
+    LightGrid::WriteBuffer();
+    I2CBus.Run();
+    Host.Nack[0x70] = false;
+    Host.ClearI2CLog();
+
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(1, Host.I2CCount);
+    TEST_ASSERT_EQUAL(17, Host.I2CLog[0].Length);
+}
+
+void test_ram_matches_after_many_changes() {
+    uint8_t expected[16];
+
+    srand(29);
+    for (uint16_t frame = 0; frame < 200; frame++) {
+        for (uint8_t i = rand() % 4; i > 0; i--)
+            LightGrid::SetPixel(0, rand() % 8, rand() % 12, rand() % 2);
+
+        LightGrid::WriteBuffer();
+        if (rand() % 3 == 0) I2CBus.Run();
+    }
+    I2CBus.Run();
+
+    // One more full frame from a fresh Init gives the reference image.
+    memcpy(expected, Host.Registers[0x70], sizeof(expected));
+    memset(Host.Registers[0x70], 0, sizeof(expected));
+    LightGrid::Init();
+    LightGrid::WriteBuffer();
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(Host.Registers[0x70], expected, sizeof(expected));
+}
+
+//=============================================================================
+// Wiring
+//-----------------------------------------------------------------------------
+void test_each_pixel_reaches_its_wired_bit() {
+    for (uint8_t x = 0; x < 8; x++) {
+        for (uint8_t y = 0; y < 12; y++) {
+            bool pixels[8][12] = {{false}};
+            uint8_t expected[16];
+            pixels[x][y] = true;
+            Reference(pixels, expected);
+
+            LightGrid::ClearBuffer();
+            LightGrid::SetPixel(0, x, y, 1);
+            Send();
+
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, Host.Registers[0x70], 16);
+        }
+    }
+}
+
+void test_set_column_matches_pixels() {
+    bool pixels[8][12] = {{false}};
+    uint8_t expected[16];
+
+    srand(30);
+    LightGrid::ClearBuffer();
+    for (uint8_t x = 0; x < 8; x++) {
+        uint16_t const rows = rand() & 0x0FFF;
+        LightGrid::SetColumn(0, x, rows);
+
+        for (uint8_t y = 0; y < 12; y++)
+            pixels[x][y] = rows & (1 << y);
+    }
+    Send();
+
+    Reference(pixels, expected);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, Host.Registers[0x70], 16);
+}
+
+void test_set_row_matches_pixels() {
+    bool pixels[8][12] = {{false}};
+    uint8_t expected[16];
+
+    srand(31);
+    LightGrid::ClearBuffer();
+    for (uint16_t i = 0; i < 100; i++) {
+        uint8_t const y = rand() % 12;
+        uint8_t const columns = rand();
+        LightGrid::SetRow(0, y, columns);
+
+        for (uint8_t x = 0; x < 8; x++)
+            pixels[x][y] = columns & (1 << x);
+    }
+    Send();
+
+    Reference(pixels, expected);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, Host.Registers[0x70], 16);
+}
+
+void test_invert_and_lit_pixels() {
+    LightGrid::ClearBuffer();
+    LightGrid::SetPixel(0, 1, 2, 1);
+    LightGrid::SetPixel(0, 6, 11, 1);
+    TEST_ASSERT_EQUAL(2, LightGrid::LitPixels());
+
+    LightGrid::InvertBuffer();
+    TEST_ASSERT_EQUAL(94, LightGrid::LitPixels());
+}
+
+//=============================================================================
+// Traffic
+//-----------------------------------------------------------------------------
+// Every write used to send the whole RAM image. What is sent, what the
+// counters say was saved and the frames skipped make up that baseline.
+static void AssertAgainstWholeFrames(uint16_t const writes, uint32_t const saved,
+                                     uint32_t const skipped, uint8_t const percent) {
+    uint32_t const bytes = PanelBytes();
+    uint32_t const baseline = (uint32_t)writes * FullFrame;
+
+    TEST_ASSERT_EQUAL(baseline, bytes + (LightGrid::BytesSaved - saved) +
+                                (LightGrid::FramesSkipped - skipped) * FullFrame);
+    TEST_ASSERT_TRUE(bytes > 0);
+    TEST_ASSERT_LESS_OR_EQUAL(baseline * percent / 100, bytes);
+}
+
+// A scroll tick moves every lit column, so only the blank lead in is saved.
+void test_scroll_sends_less_than_whole_frames() {
+    uint16_t const ticks = 400;
+
+    StartDisplay();
+    Display.UpdateRotation(0);
+    Display.SetString(Display_PRIMARY_Show, "Hello World 0123456789");
+    Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+    Display.ScrollReset();
+    I2CBus.Run();
+    Host.ClearI2CLog();
+    uint32_t const saved = LightGrid::BytesSaved;
+    uint32_t const skipped = LightGrid::FramesSkipped;
+
+    for (uint16_t tick = 0; tick < ticks; tick++) {
+        Host.Run(ScrollMs);
+        I2CBus.Run();
+    }
+
+    AssertAgainstWholeFrames(ticks, saved, skipped, 92);
+}
+
+// Joystick positions as the app sends them, one pixel moved each time, first
+// with the grid cleared each time and then leaving a trail. Only the columns
+// the pixel left and entered are sent.
+void test_joystick_sends_less_than_whole_frames() {
+    uint16_t const moves = 400;
+    uint8_t x = 4, y = 6;
+
+    StartDisplay();
+    Display.SetMode(Display_PRIMARY_Show, Display_Manual_Mode);
+    Display.Clear();
+    Display.WriteBuffer();
+    I2CBus.Run();
+    Host.ClearI2CLog();
+    uint32_t const saved = LightGrid::BytesSaved;
+    uint32_t const skipped = LightGrid::FramesSkipped;
+
+    srand(29);
+    for (uint16_t move = 0; move < moves; move++) {
+        x = (x + 8 + rand() % 3 - 1) % 8;
+        y = (y + 12 + rand() % 3 - 1) % 12;
+
+        if (move < moves / 2)
+            Display.Clear();
+        Display.SetPixel(x, y, 0x01);
+        Display.WriteBuffer();
+        I2CBus.Run();
+    }
+
+    AssertAgainstWholeFrames(moves, saved, skipped, 20);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_is_whole);
+    RUN_TEST(test_unchanged_frame_is_skipped);
+    RUN_TEST(test_one_column_sends_its_bytes);
+    RUN_TEST(test_pending_frame_widens_to_both_changes);
+    RUN_TEST(test_failed_frame_resends_whole);
+    RUN_TEST(test_ram_matches_after_many_changes);
+    RUN_TEST(test_each_pixel_reaches_its_wired_bit);
+    RUN_TEST(test_set_column_matches_pixels);
+    RUN_TEST(test_set_row_matches_pixels);
+    RUN_TEST(test_invert_and_lit_pixels);
+    RUN_TEST(test_scroll_sends_less_than_whole_frames);
+    RUN_TEST(test_joystick_sends_less_than_whole_frames);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,479 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Mobility ramps, mixing, faults and deadman, seen in the DRV8830
+//              registers.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <HostFakes.h>
+#include "DRV8830.h"				// DRV8830 Header file
+#include "Mobility.h"				// Mobility Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Right       DRV8830_Addr0
+#define Left        DRV8830_Addr2
+#define VsetMin     6
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+// Writing the clear bit clears the fault bits.
+static void Drv8830(uint8_t const addr, uint8_t const *const data, uint8_t const length) {
+    if (length >= 2 && data[0] == DRV8830_Fault && (data[1] & DRV8830_FaultClear))
+        Host.Registers[addr][DRV8830_Fault] = 0;
+}
+
+// The signed VSET step a motor is driven at.
+static int8_t Output(uint8_t const addr) {
+    uint8_t const control = Host.Registers[addr][DRV8830_Control];
+    int8_t const vset = (control >> 2) - VsetMin;
+
+    switch (control & 0x03) {
+        case DRV8830_Forward: return vset;
+        case DRV8830_Reverse: return -vset;
+        default: return 0;
+    }
+}
+
+static uint8_t Bridge(uint8_t const addr) {
+    return Host.Registers[addr][DRV8830_Control] & 0x03;
+}
+
+// Run to the next control tick.
+static void Tick() {
+    Host.Run(Mobility_ControlPeriodMs);
+}
+
+// Ticks until the right motor settles on its value, checking each step.
+static uint8_t Follow(int8_t const goal, uint8_t const step, uint8_t const reverseStep) {
+    int8_t output = Output(Right);
+    uint8_t ticks = 0;
+
+    while (output != goal && ticks < 100) {
+        Tick();
+        ticks++;
+        int8_t const next = Output(Right);
+
+        // Never through zero in one tick, and never faster than the ramp.
+        TEST_ASSERT_FALSE((output > 0 && next < 0) || (output < 0 && next > 0));
+        TEST_ASSERT_LESS_OR_EQUAL((output > 0 && goal < output) || (output < 0 && goal > output) ? reverseStep : step,
+                                  abs(next - output));
+        TEST_ASSERT_TRUE(next != output);
+        output = next;
+    }
+
+    return ticks;
+}
+
+// The wheel speeds worked out in floating point, halves rounded away from zero.
+static void Reference(int8_t const speed, int8_t const steer, int8_t *const left, int8_t *const right) {
+    double const l = speed + steer;
+    double const r = speed - steer;
+    double scale = fabs(l) > fabs(r) ? fabs(l) : fabs(r);
+    if (scale < Mobility_InputMax) scale = Mobility_InputMax;
+
+    *left = (int8_t)round(l * DRV8830_MaxSpeed / scale);
+    *right = (int8_t)round(r * DRV8830_MaxSpeed / scale);
+}
+
+// A fault the chip would report, until it is cleared.
+static void Fault(uint8_t const addr, uint8_t const bits) {
+    Host.Registers[addr][DRV8830_Fault] = DRV8830_FaultBit | bits;
+}
+
+// Two current limits close together, each found by the next fault poll.
+static void ILimitTwice() {
+    Fault(Right, DRV8830_FaultILimit);
+    Host.Run(Mobility_ControlPeriodMs * (Mobility_FaultPollDrive + 2));
+    Fault(Right, DRV8830_FaultILimit);
+    Host.Run(Mobility_ControlPeriodMs * (Mobility_FaultPollDrive + 2));
+}
+
+// Ms until the right motor is back to full speed.
+static uint32_t UntilFull() {
+    uint32_t ms = 0;
+
+    while (Output(Right) != DRV8830_MaxSpeed && ms < 60000) {
+        Host.Run(Mobility_ControlPeriodMs);
+        ms += Mobility_ControlPeriodMs;
+    }
+
+    return ms;
+}
+
+// The deadman trip count, the last figure in the link summary.
+static uint32_t DeadmanTrips() {
+    char text[Mobility_LinkSummarySize];
+    (void)Mobility.LinkSummary(text, sizeof(text));
+
+    const char *const trips = strstr(text, "deadman ");
+    TEST_ASSERT_NOT_NULL(trips);
+    return strtoul(trips + strlen("deadman "), NULL, 10);
+}
+
+// Ms from driving the right motor until it is off again.
+static uint32_t UntilOff() {
+    uint32_t const startMs = millis();
+
+    while (Output(Right) == 0 && millis() - startMs < 10000)
+        Host.Run(1);
+    while (Output(Right) != 0 && millis() - startMs < 10000)
+        Host.Run(1);
+
+    return millis() - startMs;
+}
+
+// Begin sets the control loop timer, so it is only called once. Each test
+// starts with the rover at rest and the default ramps. The deadman is off,
+// as most tests hold one setpoint for seconds.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Host.WriteHook = Drv8830;
+        Mobility.Begin();
+        started = true;
+    }
+
+    Mobility.SetObstacle(false);
+    Mobility.SetDeadman(0, false);
+    Mobility.SetRamp(Mobility_AccelStep, Mobility_DecelStep, Mobility_ReverseStep);
+    Mobility.SetDrive(0, 0);
+    Host.Run(1500);
+    Host.ClearI2CLog();
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// Ramps
+//-----------------------------------------------------------------------------
+void test_speeds_up_at_the_accel_rate() {
+    Mobility.SetDrive(100, 0);
+
+    TEST_ASSERT_EQUAL(29, Follow(DRV8830_MaxSpeed, Mobility_AccelStep, Mobility_AccelStep));
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Left));
+}
+
+void test_slows_down_at_the_decel_rate() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+
+    // 57 to 17 is 40 steps, 4 a tick.
+    Mobility.SetDrive(30, 0);
+    TEST_ASSERT_EQUAL(10, Follow(17, Mobility_DecelStep, Mobility_DecelStep));
+}
+
+void test_reverses_through_zero() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+
+    // Down at 3 a tick to rest, 19 ticks, then up the other way at 2, 29 more.
+    Mobility.SetDrive(-100, 0);
+    TEST_ASSERT_EQUAL(19, Follow(0, Mobility_ReverseStep, Mobility_ReverseStep));
+    TEST_ASSERT_EQUAL(29, Follow(-DRV8830_MaxSpeed, Mobility_AccelStep, Mobility_AccelStep));
+}
+
+void test_no_ramp_changes_at_once() {
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(100, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+
+    // A change of direction still rests for one tick.
+    Mobility.SetDrive(-100, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(0, Output(Right));
+    Tick();
+    TEST_ASSERT_EQUAL(-DRV8830_MaxSpeed, Output(Right));
+}
+
+void test_emergency_stop_skips_the_ramp() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+
+    // Braked in the call, not at the next tick.
+    Mobility.EmergencyStop();
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Left));
+
+    Host.Run(500);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+}
+
+void test_obstacle_brakes_forward_but_not_reverse() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+
+    TEST_ASSERT_TRUE(Mobility.SetObstacle(true));
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+    Host.Run(200);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+
+    // Backing away ramps up as usual.
+    Mobility.SetDrive(-100, 0);
+    TEST_ASSERT_EQUAL(29, Follow(-DRV8830_MaxSpeed, Mobility_AccelStep, Mobility_AccelStep));
+}
+
+//=============================================================================
+// Mixing
+//-----------------------------------------------------------------------------
+void test_mix_matches_the_reference() {
+    Mobility.SetRamp(0, 0, 0);
+
+    for (int16_t speed = -Mobility_InputMax; speed <= Mobility_InputMax; speed += 5) {
+        for (int16_t steer = -Mobility_InputMax; steer <= Mobility_InputMax; steer += 5) {
+            int8_t left, right;
+            Reference(speed, steer, &left, &right);
+
+            // Two ticks, in case a wheel changes direction through rest.
+            Mobility.SetDrive(speed, steer);
+            Tick();
+            Tick();
+
+            TEST_ASSERT_EQUAL(left, Output(Left));
+            TEST_ASSERT_EQUAL(right, Output(Right));
+        }
+    }
+}
+
+void test_steer_turns_smoothly() {
+    int8_t previous = 0;
+    Mobility.SetRamp(0, 0, 0);
+
+    // With the speed held, each step of steer moves a wheel at most one VSET step.
+    for (int16_t steer = 0; steer <= Mobility_InputMax; steer++) {
+        Mobility.SetDrive(60, steer);
+        Tick();
+
+        if (steer > 0)
+            TEST_ASSERT_LESS_OR_EQUAL(1, abs(Output(Left) - previous));
+        previous = Output(Left);
+        TEST_ASSERT_GREATER_OR_EQUAL(Output(Right), Output(Left));
+    }
+}
+
+void test_spin_does_not_release_a_stop() {
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(100, 0);
+    Tick();
+    Mobility.EmergencyStop();
+
+    // Full steer with no speed is a spin, not the joystick let go.
+    Mobility.SetDrive(0, Mobility_InputMax);
+    Host.Run(200);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Left));
+    TEST_ASSERT_TRUE(Mobility.IsStopped());
+
+    Mobility.SetDrive(0, 0);
+    TEST_ASSERT_FALSE(Mobility.IsStopped());
+    Mobility.SetDrive(0, Mobility_InputMax);
+    Tick();
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Left));
+    TEST_ASSERT_EQUAL(-DRV8830_MaxSpeed, Output(Right));
+}
+
+void test_script_brake_released_by_the_next_step() {
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.ScriptBrake();
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+
+    Mobility.ScriptDrive(50, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(29, Output(Right));
+
+    // A script step does not let go of a stop from the app.
+    Mobility.EmergencyStop();
+    Mobility.ScriptDrive(50, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+}
+
+//=============================================================================
+// Fault monitor
+//-----------------------------------------------------------------------------
+void test_current_limit_backs_off_and_recovers() {
+    char text[Mobility_FaultSummarySize];
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+    UntilFull();
+
+    ILimitTwice();
+    Host.Run(200);
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed - Mobility_LimitBackoff, Output(Right));
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Left));
+    Mobility.FaultSummary(Mobility_FrontRightMotor, text, sizeof(text));
+    TEST_ASSERT_TRUE(strstr(text, "VSET max 49") != NULL);
+
+    // Given back after a quiet Mobility_LimitRecoverMs.
+    uint32_t const ms = UntilFull();
+    TEST_ASSERT_INT_WITHIN(500, Mobility_LimitRecoverMs, ms);
+}
+
+void test_current_limit_stops_at_the_floor() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+    UntilFull();
+
+    for (uint8_t i = 0; i < 6; i++)
+        ILimitTwice();
+    Host.Run(500);
+    TEST_ASSERT_EQUAL(Mobility_LimitFloor, Output(Right));
+
+    // 25 back up to 57 is four steps of 8, one each quiet period.
+    uint32_t const ms = UntilFull();
+    TEST_ASSERT_INT_WITHIN(1000, 4 * Mobility_LimitRecoverMs, ms);
+}
+
+void test_failed_reads_are_not_quiet() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+    UntilFull();
+    ILimitTwice();
+
+    Host.Run(1000);
+    Host.Nack[Right] = true;
+    Host.Run(3000);
+    Host.Nack[Right] = false;
+
+    // No answer for 3 s, so the quiet time starts again once it answers.
+    Host.Run(Mobility_LimitRecoverMs - 3000);
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed - Mobility_LimitBackoff, Output(Right));
+
+    uint32_t const ms = UntilFull();
+    TEST_ASSERT_INT_WITHIN(500, 3000, ms);
+}
+
+void test_over_temperature_rests_the_motor() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+    UntilFull();
+
+    Fault(Right, DRV8830_FaultOts);
+    Host.Run(Mobility_ControlPeriodMs * (Mobility_FaultPollDrive + 2));
+    TEST_ASSERT_EQUAL(0, Output(Right));
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Left));
+
+    // It stays off while cooling, even with the chip's fault cleared.
+    Host.Registers[Right][DRV8830_Fault] = 0;
+    Host.Run(Mobility_ThermalCoolMs - 500);
+    TEST_ASSERT_EQUAL(0, Output(Right));
+
+    uint32_t const ms = UntilFull();
+    TEST_ASSERT_LESS_OR_EQUAL(2000, ms);
+}
+
+//=============================================================================
+// Deadman
+//-----------------------------------------------------------------------------
+void test_deadman_is_on_by_default() {
+    static MobilityClass const fresh;
+    TEST_ASSERT_GREATER_THAN(0, fresh.DeadmanMs());
+    TEST_ASSERT_EQUAL(Mobility_DeadmanMs, fresh.DeadmanMs());
+
+    uint32_t const trips = DeadmanTrips();
+    Mobility.SetDeadman(fresh.DeadmanMs(), false);
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(100, 0);
+
+    TEST_ASSERT_LESS_OR_EQUAL(Mobility_DeadmanMs + Mobility_ControlPeriodMs, UntilOff());
+    TEST_ASSERT_EQUAL(trips + 1, DeadmanTrips());
+}
+
+void test_deadman_coasts_without_input() {
+    uint32_t const trips = DeadmanTrips();
+    Mobility.SetDeadman(800, false);
+    Mobility.SetDrive(100, 0);
+    Host.Run(700);
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+
+    // Full speed is cut on the tick it trips, not ramped down at the decel rate.
+    int8_t before = Output(Right);
+    for (uint8_t ticks = 0; ticks < 20 && DeadmanTrips() == trips; ticks++) {
+        before = Output(Right);
+        Tick();
+    }
+    TEST_ASSERT_EQUAL(trips + 1, DeadmanTrips());
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, before);
+    TEST_ASSERT_EQUAL(DRV8830_Coast, Bridge(Right));
+    TEST_ASSERT_EQUAL(DRV8830_Coast, Bridge(Left));
+    TEST_ASSERT_EQUAL(0, Output(Left));
+
+    // Input again drives again.
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(100, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+}
+
+void test_deadman_brake_held_until_let_go() {
+    uint32_t const trips = DeadmanTrips();
+    Mobility.SetDeadman(200, true);
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(100, 0);
+
+    TEST_ASSERT_LESS_OR_EQUAL(200 + Mobility_ControlPeriodMs, UntilOff());
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+    TEST_ASSERT_EQUAL(trips + 1, DeadmanTrips());
+
+    // The link comes back with the joystick still held over.
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Bridge(Right));
+
+    Mobility.SetDrive(0, 0);
+    Mobility.SetDrive(100, 0);
+    Tick();
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+}
+
+void test_deadman_kept_off_by_steady_input() {
+    uint32_t const trips = DeadmanTrips();
+    Mobility.SetDeadman(200, false);
+    Mobility.SetRamp(0, 0, 0);
+
+    for (uint8_t i = 0; i < 30; i++) {
+        Mobility.SetDrive(100, 0);
+        Host.Run(100);
+        TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+    }
+
+    TEST_ASSERT_EQUAL(trips, DeadmanTrips());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_speeds_up_at_the_accel_rate);
+    RUN_TEST(test_slows_down_at_the_decel_rate);
+    RUN_TEST(test_reverses_through_zero);
+    RUN_TEST(test_no_ramp_changes_at_once);
+    RUN_TEST(test_emergency_stop_skips_the_ramp);
+    RUN_TEST(test_obstacle_brakes_forward_but_not_reverse);
+    RUN_TEST(test_mix_matches_the_reference);
+    RUN_TEST(test_steer_turns_smoothly);
+    RUN_TEST(test_spin_does_not_release_a_stop);
+    RUN_TEST(test_script_brake_released_by_the_next_step);
+    RUN_TEST(test_current_limit_backs_off_and_recovers);
+    RUN_TEST(test_current_limit_stops_at_the_floor);
+    RUN_TEST(test_failed_reads_are_not_quiet);
+    RUN_TEST(test_over_temperature_rests_the_motor);
+    RUN_TEST(test_deadman_is_on_by_default);
+    RUN_TEST(test_deadman_coasts_without_input);
+    RUN_TEST(test_deadman_brake_held_until_let_go);
+    RUN_TEST(test_deadman_kept_off_by_steady_input);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,253 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Motor control writes, only new values go on the bus.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "DRV8830.h"				// DRV8830 Header file
+#include "Mobility.h"				// Mobility Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Right       DRV8830_Addr0
+#define Left        DRV8830_Addr2
+#define VsetMin     6
+#define AppWriteMs  100         // The app's joystick write interval
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// The control value each chip is really using.
+static uint8_t Control[128];
+
+// A joystick session as the app writes it, speed and steer each write
+// interval. Held positions wander by a count or two under the thumb.
+static const int8_t Session[][2] = {
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0},
+    // Away, straight ahead
+    {12, 0}, {31, 1}, {55, 0}, {78, -1}, {96, 0}, {100, 0},
+    {100, 1}, {99, 0}, {100, 0}, {100, -2}, {98, 0}, {100, 0}, {100, 1}, {100, 0},
+    {100, 0}, {99, 1}, {100, 0}, {100, 0}, {100, 0}, {97, 0}, {100, -1}, {100, 0},
+    // A long right hand turn
+    {100, 8}, {95, 19}, {92, 33}, {90, 41}, {90, 42}, {91, 40}, {90, 41}, {90, 42},
+    {90, 41}, {90, 40}, {92, 35}, {96, 20}, {100, 6}, {100, 0}, {100, 0}, {100, 1},
+    // Let go, back to the middle
+    {60, 0}, {12, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0},
+    // Back up slowly
+    {-20, 0}, {-38, 0}, {-40, 1}, {-41, 0}, {-40, 0}, {-40, -1}, {-39, 0}, {-40, 0},
+    {-40, 0}, {-40, 0}, {-22, 0}, {0, 0}, {0, 0}, {0, 0},
+    // Spin on the spot to the left, and let go
+    {0, -30}, {0, -70}, {0, -100}, {0, -100}, {0, -99}, {0, -100}, {0, -100}, {0, -100},
+    {0, -100}, {0, -60}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}
+};
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+// A latched over current leaves the bridge off, a control write is taken and
+// does nothing. Writing the clear bit clears the fault bits.
+static void Drv8830(uint8_t const addr, uint8_t const *const data, uint8_t const length) {
+    if ((addr != Right && addr != Left) || length < 2)
+        return;
+
+    if (data[0] == DRV8830_Control) {
+        if (Host.Registers[addr][DRV8830_Fault] & DRV8830_FaultOcp)
+            Host.Registers[addr][DRV8830_Control] = Control[addr];
+        else
+            Control[addr] = data[1];
+    } else if (data[0] == DRV8830_Fault && (data[1] & DRV8830_FaultClear)) {
+        Host.Registers[addr][DRV8830_Fault] = 0;
+    }
+}
+
+// The signed VSET step a motor is driven at.
+static int8_t Output(uint8_t const addr) {
+    uint8_t const control = Host.Registers[addr][DRV8830_Control];
+    int8_t const vset = (control >> 2) - VsetMin;
+
+    switch (control & 0x03) {
+        case DRV8830_Forward: return vset;
+        case DRV8830_Reverse: return -vset;
+        default: return 0;
+    }
+}
+
+static uint16_t ControlWrites(uint8_t const addr) {
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < Host.I2CCount; i++) {
+        Host_I2C_t const *const trans = &Host.I2CLog[i];
+        if (trans->Addr == addr && !trans->Read && trans->Length == 2 && trans->Data[0] == DRV8830_Control)
+            count++;
+    }
+
+    return count;
+}
+
+// Begin sets the control loop timer, so it is only called once. Each test
+// starts with the rover at rest and the default ramps, the deadman off so a
+// setpoint can be held.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Host.WriteHook = Drv8830;
+        Mobility.Begin();
+        started = true;
+    }
+
+    memset(Host.Nack, 0, sizeof(Host.Nack));
+    Host.Registers[Right][DRV8830_Fault] = 0;
+    Host.Registers[Left][DRV8830_Fault] = 0;
+    Mobility.SetDeadman(0, false);
+    Mobility.SetRamp(Mobility_AccelStep, Mobility_DecelStep, Mobility_ReverseStep);
+    Mobility.SetDrive(0, 0);
+    Host.Run(1500);
+    Host.ClearI2CLog();
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// Tests
+//-----------------------------------------------------------------------------
+void test_steady_setpoint_is_not_written_again() {
+    Mobility.SetDrive(60, 0);
+    Host.Run(1000);
+    TEST_ASSERT_EQUAL(34, Output(Right));
+    TEST_ASSERT_EQUAL(34, Output(Left));
+    Host.ClearI2CLog();
+
+    // Repeats of the same setpoint, as a joystick held still sends.
+    for (uint8_t i = 0; i < 20; i++) {
+        Mobility.SetDrive(60, 0);
+        Host.Run(50);
+    }
+
+    TEST_ASSERT_EQUAL(0, ControlWrites(Right));
+    TEST_ASSERT_EQUAL(0, ControlWrites(Left));
+}
+
+void test_ramp_writes_each_new_value_once() {
+    Mobility.SetDrive(100, 0);
+    Host.Run(1000);
+
+    // 0 to 57 two steps a tick is 29 new values.
+    TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+    TEST_ASSERT_EQUAL(29, ControlWrites(Right));
+    TEST_ASSERT_EQUAL(29, ControlWrites(Left));
+
+    uint8_t previous = 0;
+    for (uint16_t i = 0; i < Host.I2CCount; i++) {
+        Host_I2C_t const *const trans = &Host.I2CLog[i];
+        if (trans->Addr == Right && !trans->Read && trans->Data[0] == DRV8830_Control) {
+            TEST_ASSERT_TRUE(trans->Data[1] != previous);
+            previous = trans->Data[1];
+        }
+    }
+}
+
+void test_failed_write_is_sent_again() {
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(60, 0);
+    Host.Run(100);
+    TEST_ASSERT_EQUAL(34, Output(Right));
+
+    // The stop is not taken, it must not be counted as sent.
+    Host.Nack[Right] = true;
+    Mobility.SetDrive(0, 0);
+    Host.Run(100);
+    TEST_ASSERT_EQUAL(34, Output(Right));
+
+    Host.Nack[Right] = false;
+    Host.Run(Mobility_ControlPeriodMs);
+    TEST_ASSERT_EQUAL(0, Output(Right));
+}
+
+void test_latched_over_current_drives_again() {
+    uint16_t worstMs = 0;
+    Mobility.SetRamp(0, 0, 0);
+
+    // From each point of the slow fault poll, so it is not the poll that finds it.
+    for (uint8_t rest = 0; rest < Mobility_FaultPollIdle; rest += 7) {
+        Mobility.SetDrive(0, 0);
+        Host.Run(Mobility_ControlPeriodMs * (Mobility_FaultPollDrive + rest));
+        Host.Registers[Right][DRV8830_Fault] = DRV8830_FaultBit | DRV8830_FaultOcp;
+        Host.Registers[Left][DRV8830_Fault] = DRV8830_FaultBit | DRV8830_FaultOcp;
+        Mobility.SetDrive(100, 0);
+
+        // The first write is lost, the fault is read, cleared, and the value sent again.
+        uint16_t ms = 0;
+        while (ms < 1000 && (Output(Right) == 0 || Output(Left) == 0)) {
+            Host.Run(1);
+            ms++;
+        }
+
+        if (ms > worstMs) worstMs = ms;
+        TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Right));
+        TEST_ASSERT_EQUAL(DRV8830_MaxSpeed, Output(Left));
+        TEST_ASSERT_EQUAL_HEX8(0, Host.Registers[Right][DRV8830_Fault]);
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL(3 * Mobility_ControlPeriodMs, worstMs);
+}
+
+// Every tick used to write both control registers. Now only a new value is
+// sent, the rest are counted as suppressed.
+void test_joystick_session_writes() {
+    uint16_t const writes = sizeof(Session) / sizeof(Session[0]);
+    uint16_t const ticks = writes * AppWriteMs / Mobility_ControlPeriodMs;
+    uint32_t const issued = Mobility.WritesIssued();
+    uint32_t const suppressed = Mobility.WritesSuppressed();
+
+    for (uint16_t i = 0; i < writes; i++) {
+        Mobility.SetDrive(Session[i][0], Session[i][1]);
+        Host.Run(AppWriteMs);
+    }
+
+    uint32_t const newIssued = Mobility.WritesIssued() - issued;
+    uint32_t const newSuppressed = Mobility.WritesSuppressed() - suppressed;
+    uint16_t transactions = 0;
+    uint16_t bytes = 0;
+
+    for (uint16_t i = 0; i < Host.I2CCount; i++) {
+        if (Host.I2CLog[i].Addr == Right || Host.I2CLog[i].Addr == Left) {
+            transactions++;
+            bytes += Host.I2CLog[i].Length;
+        }
+    }
+
+    // Each tick is one write or one skip for each motor, and each write reaches the bus.
+    TEST_ASSERT_EQUAL(Mobility_MotorCount * ticks, newIssued + newSuppressed);
+    TEST_ASSERT_EQUAL(newIssued, ControlWrites(Right) + ControlWrites(Left));
+
+    // The rest of the traffic is the fault polls, a register address and the fault byte.
+    TEST_ASSERT_EQUAL(transactions - newIssued, bytes - 2 * newIssued);
+
+    // Written every tick, the control writes alone were 830 and 1660 bytes.
+    TEST_ASSERT_EQUAL(267, newIssued);
+    TEST_ASSERT_EQUAL(563, newSuppressed);
+    TEST_ASSERT_EQUAL(411, transactions);
+    TEST_ASSERT_EQUAL(678, bytes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_setpoint_is_not_written_again);
+    RUN_TEST(test_ramp_writes_each_new_value_once);
+    RUN_TEST(test_failed_write_is_sent_again);
+    RUN_TEST(test_latched_over_current_drives_again);
+    RUN_TEST(test_joystick_session_writes);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
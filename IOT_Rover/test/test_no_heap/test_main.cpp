@@ -0,0 +1,197 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Format text, and a long Display soak that never uses the heap.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+//
+// String is only declared on the host, so any use of it fails to link. Every
+// operator new is counted here, the soak must not make any.
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <new>
+#include <unity.h>
+#include <HostFakes.h>
+#include "Display.h"				// Display Header file
+#include "Format.h"					// Format Header file
+#include "LightGrid.h"				// LightGrid Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define SoakSeconds     600
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static uint32_t Allocations = 0;
+static uint32_t StreamPulls = 0;
+
+//*****************************************************************************
+// Heap
+//-----------------------------------------------------------------------------
+void* operator new(size_t size) {
+    Allocations++;
+    void *const p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    free(p);
+}
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static uint8_t Source(char *const buffer, uint8_t const size) {
+    StreamPulls++;
+    return Format.Unsigned(buffer, size, Format.Text(buffer, size, 0, " Line "), StreamPulls);
+}
+
+//=============================================================================
+// Format
+//-----------------------------------------------------------------------------
+void test_format_numbers() {
+    char text[24];
+    uint8_t length;
+
+    length = Format.Text(text, sizeof(text), 0, "T=");
+    length = Format.Int(text, sizeof(text), length, -2147483647 - 1);
+    TEST_ASSERT_EQUAL_STRING("T=-2147483648", text);
+    TEST_ASSERT_EQUAL(13, length);
+
+    Format.Unsigned(text, sizeof(text), 0, 4294967295u);
+    TEST_ASSERT_EQUAL_STRING("4294967295", text);
+    Format.Int(text, sizeof(text), 0, 0);
+    TEST_ASSERT_EQUAL_STRING("0", text);
+    Format.Hex(text, sizeof(text), 0, 0xA5, 4);
+    TEST_ASSERT_EQUAL_STRING("00a5", text);
+    Format.Hex(text, sizeof(text), 0, 0xDEADBEEF, 2);
+    TEST_ASSERT_EQUAL_STRING("deadbeef", text);
+    Format.Fixed(text, sizeof(text), 0, 0.05f, 2);
+    TEST_ASSERT_EQUAL_STRING("0.05", text);
+    Format.Fixed(text, sizeof(text), 0, -1.5f, 0);
+    TEST_ASSERT_EQUAL_STRING("-2", text);
+}
+
+void test_format_fixed_matches_printf() {
+    char text[24];
+    char expected[24];
+
+    // Whole units of the last place and a quarter, so there is no tie to round.
+    srand(37);
+    for (uint16_t i = 0; i < 5000; i++) {
+        uint8_t const decimals = rand() % 4;
+        int32_t const units = rand() % 2000000 - 1000000;
+        float const scale = decimals == 0 ? 1 : (decimals == 1 ? 10 : (decimals == 2 ? 100 : 1000));
+        float const value = (units + 0.25f) / scale;
+
+        Format.Fixed(text, sizeof(text), 0, value, decimals);
+        snprintf(expected, sizeof(expected), "%.*f", decimals, (double)value);
+        TEST_ASSERT_EQUAL_STRING(expected, text);
+    }
+}
+
+void test_format_stops_at_the_end() {
+    char text[6];
+    uint8_t length = Format.Text(text, sizeof(text), 0, "abc");
+    length = Format.Unsigned(text, sizeof(text), length, 12345);
+
+    TEST_ASSERT_EQUAL(5, length);
+    TEST_ASSERT_EQUAL_STRING("abc12", text);
+
+    uint64_t value;
+    TEST_ASSERT_TRUE(Format.ParseHex("0badF00dxx", 8, &value));
+    TEST_ASSERT_EQUAL_HEX64(0x0BADF00D, value);
+    TEST_ASSERT_FALSE(Format.ParseHex("12g4", 4, &value));
+    TEST_ASSERT_EQUAL_HEX64(0x12, value);
+}
+
+//=============================================================================
+// Display soak
+//-----------------------------------------------------------------------------
+void test_display_soak_without_heap() {
+    char text[Display_MaxStringLength + 1];
+
+    Display.SetPanels(2, LightGrid_NaturalOrder);
+    TEST_ASSERT_TRUE(Display.Init());
+    Display.SetStreamSource(Source);
+    Display.SetIdleTimeout(30);
+
+    uint32_t const allocations = Allocations;
+    uint32_t const frames = LightGrid::FramesWritten;
+    srand(38);
+
+    for (uint32_t second = 0; second < SoakSeconds; second++) {
+        switch (second % 10) {
+            case 0:
+                Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+                Format.Fixed(text, sizeof(text), Format.Text(text, sizeof(text), 0, "Temp "), rand() % 4000 / 100.0f, 1);
+                Display.SetString(Display_PRIMARY_Show, text);
+                break;
+            case 2:
+                Display.SetNumber(Display_PRIMARY_Show, rand() - RAND_MAX / 2);
+                break;
+            case 3:
+                Display.SetString(Display_TEMPORARY_Show, "Hello there");
+                Display.SetMode(Display_TEMPORARY_Show, Display_String_Mode);
+                Display.ActivateTempShow(1500);
+                break;
+            case 5:
+                Display.SetMode(Display_PRIMARY_Show, Display_U64_Mode);
+                Display.SetU64Image(Display_PRIMARY_Show, ((uint64_t)rand() << 32) | rand(), 2);
+                Display.SetU64Count(Display_PRIMARY_Show, 3);
+                break;
+            case 6:
+                Display.UpdateRotation(rand() % 4);
+                break;
+            case 7:
+                Display.SetMode(Display_PRIMARY_Show, Display_Stream_Mode);
+                Display.StreamAppend("Hi ");
+                break;
+            case 8:
+                Display.SetBrightness(rand() % 16);
+                break;
+        }
+
+        // Now and then leave it alone long enough to fade and sleep.
+        if (second % 100 == 50)
+            Host.Run(40000);
+
+        Host.Run(1000);
+        I2CBus.Run();
+    }
+
+    TEST_ASSERT_EQUAL(allocations, Allocations);
+    TEST_ASSERT_GREATER_THAN(frames + SoakSeconds, LightGrid::FramesWritten);
+    TEST_ASSERT_GREATER_THAN(0, StreamPulls);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_format_numbers);
+    RUN_TEST(test_format_fixed_matches_printf);
+    RUN_TEST(test_format_stops_at_the_end);
+    RUN_TEST(test_display_soak_without_heap);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
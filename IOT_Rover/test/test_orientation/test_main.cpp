@@ -0,0 +1,232 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Scrolled text and images in every rotation, against the
+//              mapping Display used before the message was pre-rendered.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "Display.h"				// Display Header file
+#include "Font.h"					// Font Header file
+#include "I2CBus.h"					// I2CBus Header file
+#include "LightGrid.h"				// LightGrid Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define ScrollMs        50          // Display's default scroll interval
+#define MaxImages       64          // 8 column images along the longest message
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// How the board is wired, the HT16K33 row of each grid row, and the RAM
+// column of each grid column.
+static const uint8_t RowWire[12] = {7, 6, 3, 2, 0, 1, 4, 5, 8, 11, 10, 9};
+static const uint8_t ColumnWire[8] = {2, 1, 3, 4, 5, 6, 7, 0};
+
+// The message as it used to be scrolled, two blank images, the message and
+// blanks after, each image 8 columns along the scroll.
+static uint64_t Images[MaxImages];
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+// Init sets the scroll timer, so it is only called once.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Display.SetPanels(1, LightGrid_NaturalOrder);
+        TEST_ASSERT_TRUE(Display.Init());
+        started = true;
+    }
+
+    memset(Images, 0, sizeof(Images));
+}
+
+void tearDown() {
+}
+
+static uint8_t ReverseU8(uint8_t x) {
+    x = ((x >> 1) & 0x55) | ((x & 0x55) << 1);
+    x = ((x >> 2) & 0x33) | ((x & 0x33) << 2);
+    return (x >> 4) | (x << 4);
+}
+
+// DisplayClass::SetTrippleImage64 as it was, the grid kept as logical
+// columns of 12 rows, as the old LightGrid did before the wiring was applied.
+static void SetTrippleImage64(uint16_t grid[8], uint8_t const rotation, uint64_t const aa64,
+                              uint64_t const bb64, uint64_t const cc64, uint8_t leftShift) {
+    uint8_t rowArray[24];
+
+    if (leftShift > 12)
+        leftShift = 12;
+
+    for (uint8_t imageRow = 0; imageRow < 8; imageRow++) {
+        uint8_t rowDataA = aa64 >> (imageRow*8);
+        uint8_t rowDataB = bb64 >> (imageRow*8);
+        uint8_t rowDataC = cc64 >> (imageRow*8);
+
+        if (rotation == 0x03 || rotation == 0x00) {
+            rowDataA = ReverseU8(rowDataA);
+            rowDataB = ReverseU8(rowDataB);
+            rowDataC = ReverseU8(rowDataC);
+        }
+
+        if (rotation & 0x02) {
+            uint32_t rowData32;
+
+            if (rotation & 0x01) {
+                rowData32 = ((uint32_t)rowDataA << 16) | ((uint32_t)rowDataB << 8) | rowDataC;
+                grid[7-imageRow] = (uint16_t)(rowData32 >> (12 - leftShift)) & 0x0FFF;
+            } else {
+                rowData32 = ((uint32_t)rowDataC << 16) | ((uint32_t)rowDataB << 8) | rowDataA;
+                grid[imageRow] = (uint16_t)(rowData32 >> leftShift) & 0x0FFF;
+            }
+        } else {
+            rowArray[23-imageRow] = rowDataA;
+            rowArray[15-imageRow] = rowDataB;
+            rowArray[7-imageRow] = rowDataC;
+        }
+    }
+
+    if (rotation < 0x02) {
+        for (uint8_t displayRow = 0; displayRow < 12; displayRow++) {
+            uint8_t const row = (rotation & 0x01) ? displayRow : 11 - displayRow;
+            uint8_t const val = rowArray[displayRow + 12 - leftShift];
+
+            for (uint8_t col = 0; col < 8; col++) {
+                if (val & (0x01 << col))
+                    grid[col] |= 0x01 << row;
+                else
+                    grid[col] &= ~(0x01 << row);
+            }
+        }
+    }
+}
+
+// The panel RAM the old mapping gives at a scroll position, in columns from the start.
+static void Reference(uint8_t const rotation, uint16_t const position, uint8_t ram[16]) {
+    uint16_t grid[8] = {0};
+    uint8_t const element = position / 8;
+
+    SetTrippleImage64(grid, rotation, Images[element], Images[element + 1], Images[element + 2], position % 8);
+
+    memset(ram, 0, 16);
+    for (uint8_t x = 0; x < 8; x++) {
+        for (uint8_t y = 0; y < 12; y++) {
+            if (grid[x] & (0x01 << y))
+                ram[ColumnWire[x] * 2 + RowWire[y] / 8] |= 1 << (RowWire[y] % 8);
+        }
+    }
+}
+
+// Scroll the message from the start to where it has left the display, each
+// tick one column on, and check every frame.
+static void CheckScroll(uint8_t const rotation, uint16_t const columns) {
+    uint8_t expected[16];
+    char message[40];
+
+    Display.ScrollReset();
+
+    for (uint16_t position = 0; position <= Display_PanelWidth + Display_LeadInExtra + columns; position++) {
+        Host.Run(ScrollMs);
+        I2CBus.Run();
+
+        Reference(rotation, position, expected);
+        snprintf(message, sizeof(message), "rotation %u, position %u", rotation, position);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, Host.Registers[0x70], 16, message);
+    }
+}
+
+// Text in 8x8 cells, or in landscape packed up by the proportional font.
+// Returns the columns along the scroll.
+static uint16_t LoadText(const char *text, bool const proportional) {
+    uint16_t const lead = 2 * 8;
+    uint16_t position = lead;
+    uint8_t width;
+
+    for (uint8_t i = 0; text[i]; i++) {
+        uint64_t const image = Font.Image(text[i], !proportional, &width);
+
+        // Each image row is a byte along the scroll, split over the images it falls in.
+        for (uint8_t row = 0; row < 8; row++) {
+            uint16_t const bits = (uint16_t)(uint8_t)(image >> (row * 8)) << (position % 8);
+            Images[position / 8 + 0] |= (uint64_t)(uint8_t)(bits >> 0) << (row * 8);
+            Images[position / 8 + 1] |= (uint64_t)(uint8_t)(bits >> 8) << (row * 8);
+        }
+
+        position += proportional ? Font.Advance(text[i], text[i + 1] ? text[i + 1] : ' ') : 8;
+    }
+
+    return position - lead;
+}
+
+//=============================================================================
+// Rotations
+//-----------------------------------------------------------------------------
+void test_text_in_every_rotation() {
+    const char *const text = "Rover 42! gjq";
+
+    Display.SetString(Display_PRIMARY_Show, text);
+    Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        memset(Images, 0, sizeof(Images));
+        uint16_t const columns = LoadText(text, rotation & 0x02);
+
+        Display.UpdateRotation(rotation);
+        CheckScroll(rotation, columns);
+    }
+}
+
+void test_images_in_every_rotation() {
+    uint8_t const count = Display_U64Images - 2;
+
+    srand(32);
+    for (uint8_t i = 0; i < count; i++) {
+        uint64_t const image = ((uint64_t)rand() << 48) ^ ((uint64_t)rand() << 32) ^ ((uint64_t)rand() << 16) ^ rand();
+        Images[2 + i] = image;
+        Display.SetU64Image(Display_PRIMARY_Show, image, i);
+    }
+    Display.SetU64Count(Display_PRIMARY_Show, count);
+    Display.SetMode(Display_PRIMARY_Show, Display_U64_Mode);
+
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        Display.UpdateRotation(rotation);
+        CheckScroll(rotation, count * 8);
+    }
+}
+
+// One corner pixel of each image shows which way round it is.
+void test_single_pixel_image_in_every_rotation() {
+    for (uint8_t bit = 0; bit < 64; bit += 9) {
+        memset(Images, 0, sizeof(Images));
+        Images[2] = 1ull << bit;
+        Display.SetU64Image(Display_PRIMARY_Show, Images[2], 0);
+        Display.SetU64Count(Display_PRIMARY_Show, 1);
+        Display.SetMode(Display_PRIMARY_Show, Display_U64_Mode);
+
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            Display.UpdateRotation(rotation);
+            CheckScroll(rotation, 8);
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_text_in_every_rotation);
+    RUN_TEST(test_images_in_every_rotation);
+    RUN_TEST(test_single_pixel_image_in_every_rotation);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,215 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: Chained panels as one canvas, and the bus with twelve devices.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "Display.h"				// Display Header file
+#include "I2CBus.h"					// I2CBus Header file
+#include "LightGrid.h"				// LightGrid Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Ticks       80              // Scroll ticks recorded
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+// Eight panels, two motor drivers, the accelerometer and the distance sensor.
+static const uint8_t Devices[] = {0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x60, 0x61, 0x1D, 0x29};
+
+static uint8_t Frames[2][Ticks][16];
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+void setUp() {
+    I2CBus.Run();
+    Host.Reset();
+}
+
+void tearDown() {
+}
+
+// Init sets the scroll timer, so it is only called once.
+static void StartDisplay() {
+    static bool started = false;
+
+    Display.SetPanels(2, LightGrid_NaturalOrder);
+    if (!started)
+        TEST_ASSERT_TRUE(Display.Init());
+    started = true;
+}
+
+static bool Logged(uint8_t const addr, uint16_t const from, uint16_t const to) {
+    for (uint16_t i = from; i < to; i++) {
+        if (Host.I2CLog[i].Addr == addr)
+            return true;
+    }
+
+    return false;
+}
+
+//=============================================================================
+// LightGrid
+//-----------------------------------------------------------------------------
+void test_panels_follow_the_order() {
+    // Panel 0 at 0x73, panel 1 at 0x71, panel 2 at 0x72.
+    LightGrid::SetPanels(3, 0x00000213);
+    LightGrid::Init();
+    LightGrid::ClearBuffer();
+    LightGrid::SetPixel(1, 0, 0, 1);
+
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(3, Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x73, Host.I2CLog[0].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x71, Host.I2CLog[1].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x72, Host.I2CLog[2].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x80, Host.Registers[0x71][0x04]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, Host.Registers[0x73][0x04]);
+}
+
+void test_commands_reach_every_panel_in_use() {
+    LightGrid::SetPanels(3, LightGrid_NaturalOrder);
+    LightGrid::Init();
+
+    TEST_ASSERT_TRUE(LightGrid::Display(1));
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL(3, Host.I2CCount);
+    TEST_ASSERT_TRUE(Logged(0x70, 0, 3));
+    TEST_ASSERT_TRUE(Logged(0x71, 0, 3));
+    TEST_ASSERT_TRUE(Logged(0x72, 0, 3));
+    TEST_ASSERT_FALSE(Logged(0x73, 0, 3));
+}
+
+void test_eight_panels_frame_after_a_command() {
+    LightGrid::SetPanels(LightGrid_MaxPanels, LightGrid_NaturalOrder);
+    LightGrid::Init();
+    LightGrid::ClearBuffer();
+    uint32_t const dropped = I2CBus.Dropped;
+
+    // A command to every panel fills the display queue before the frames.
+    TEST_ASSERT_TRUE(LightGrid::Brightness(3));
+    for (uint8_t panel = 0; panel < LightGrid_MaxPanels; panel++)
+        LightGrid::SetPixel(panel, 0, 0, 1);
+
+    TEST_ASSERT_TRUE(LightGrid::WriteBuffer());
+    I2CBus.Run();
+    TEST_ASSERT_EQUAL(dropped, I2CBus.Dropped);
+
+    // Each panel has its command then its frame.
+    TEST_ASSERT_EQUAL(2 * LightGrid_MaxPanels, Host.I2CCount);
+    for (uint8_t panel = 0; panel < LightGrid_MaxPanels; panel++) {
+        TEST_ASSERT_EQUAL_HEX8(0x70 + panel, Host.I2CLog[panel].Addr);
+        TEST_ASSERT_EQUAL_HEX8(0xE3, Host.I2CLog[panel].Data[0]);
+        TEST_ASSERT_EQUAL_HEX8(0x80, Host.Registers[0x70 + panel][0x04]);
+    }
+}
+
+void test_too_many_panels_is_limited() {
+    LightGrid::SetPanels(12, LightGrid_NaturalOrder);
+    TEST_ASSERT_EQUAL(LightGrid_MaxPanels, LightGrid::PanelCount());
+    LightGrid::SetPanels(0, LightGrid_NaturalOrder);
+    TEST_ASSERT_EQUAL(1, LightGrid::PanelCount());
+}
+
+//=============================================================================
+// Display
+//-----------------------------------------------------------------------------
+void test_canvas_pixel_lands_on_its_panel() {
+    StartDisplay();
+    Display.SetMode(Display_PRIMARY_Show, Display_Manual_Mode);
+    Display.Clear();
+
+    // Along the chain, 12 is the first row of the second panel.
+    Display.SetPixel(0, 12, 1);
+    Display.WriteBuffer();
+    I2CBus.Run();
+
+    TEST_ASSERT_EQUAL_HEX8(0x80, Host.Registers[0x71][0x04]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, Host.Registers[0x70][0x04]);
+}
+
+void test_scroll_runs_across_the_chain() {
+    StartDisplay();
+    Display.UpdateRotation(0);
+    Display.SetString(Display_PRIMARY_Show, "The quick brown fox jumps over the lazy dog");
+    Display.SetMode(Display_PRIMARY_Show, Display_String_Mode);
+    Display.ScrollReset();
+
+    for (uint8_t tick = 0; tick < Ticks; tick++) {
+        Host.Run(50);
+        I2CBus.Run();
+        memcpy(Frames[0][tick], Host.Registers[0x70], 16);
+        memcpy(Frames[1][tick], Host.Registers[0x71], 16);
+    }
+
+    // What the second panel shows, the first shows a panel width later.
+    uint8_t lit = 0;
+    for (uint8_t tick = 0; tick + Display_PanelWidth < Ticks; tick++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(Frames[1][tick], Frames[0][tick + Display_PanelWidth], 16);
+
+        for (uint8_t i = 0; i < 16; i++)
+            lit |= Frames[1][tick][i];
+    }
+    TEST_ASSERT_TRUE(lit != 0);
+}
+
+//=============================================================================
+// I2CBus
+//-----------------------------------------------------------------------------
+void test_every_device_is_probed_and_tracked() {
+    TEST_ASSERT_TRUE(I2CBus.Begin(true, Devices, sizeof(Devices)));
+    TEST_ASSERT_EQUAL(I2CBus_Fast, I2CBus.ClockHz);
+
+    // Each device is probed at both clocks, the last as well as the first.
+    TEST_ASSERT_EQUAL(2 * sizeof(Devices), Host.I2CCount);
+    TEST_ASSERT_EQUAL_HEX8(0x29, Host.I2CLog[sizeof(Devices) - 1].Addr);
+    TEST_ASSERT_EQUAL_HEX8(0x29, Host.I2CLog[2 * sizeof(Devices) - 1].Addr);
+
+    for (uint8_t i = 0; i < sizeof(Devices); i++) {
+        bool found = false;
+
+        for (uint8_t slot = 0; slot < I2CBus_StatsCount; slot++) {
+            I2CBus_Stats_t const *const stats = I2CBus.GetStats(slot);
+            if (stats && stats->Addr == Devices[i])
+                found = stats->Transactions >= 2;
+        }
+        TEST_ASSERT_TRUE_MESSAGE(found, "A device has no stats");
+    }
+}
+
+void test_absent_device_does_not_stop_fast_mode() {
+    Host.Nack[0x77] = true;
+
+    TEST_ASSERT_TRUE(I2CBus.Begin(true, Devices, sizeof(Devices)));
+    TEST_ASSERT_EQUAL(I2CBus_Fast, I2CBus.ClockHz);
+
+    // Not there at the standard clock, so it is not tried again.
+    TEST_ASSERT_EQUAL(2 * sizeof(Devices) - 1, Host.I2CCount);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_panels_follow_the_order);
+    RUN_TEST(test_commands_reach_every_panel_in_use);
+    RUN_TEST(test_eight_panels_frame_after_a_command);
+    RUN_TEST(test_too_many_panels_is_limited);
+    RUN_TEST(test_canvas_pixel_lands_on_its_panel);
+    RUN_TEST(test_scroll_runs_across_the_chain);
+    RUN_TEST(test_every_device_is_probed_and_tracked);
+    RUN_TEST(test_absent_device_does_not_stop_fast_mode);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
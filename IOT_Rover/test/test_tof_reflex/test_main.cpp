@@ -0,0 +1,184 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: VL53L0X ranging for the obstacle reflex, its power and latency.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "Distance.h"				// Distance Header file
+#include "DRV8830.h"				// DRV8830 Header file
+#include "Mobility.h"				// Mobility Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Right           DRV8830_Addr0
+#define BrakeMm         120         // As Sensors, Tof_BrakeDistance
+#define HysteresisMm    15          // Tof_BrakeHysteresis
+#define ReflexPollMs    5           // Tof_ReflexInerval
+#define IdlePollMs      1000        // Tof_RunInerval
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static Distance Tof;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+// Run for a time, polling as Sensors.TofRun does. Returns the polls that had a new reading.
+static uint16_t Run(uint32_t const ms, uint16_t const pollMs) {
+    uint16_t readings = 0;
+
+    for (uint32_t i = 1; i <= ms; i++) {
+        Host.Run(1);
+        if (i % pollMs == 0 && Tof.Poll())
+            readings++;
+    }
+
+    return readings;
+}
+
+// Begin sets the control loop timer, so it is only called once. Each test
+// starts with the sensor asleep, nothing ahead and the rover at rest.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Mobility.Begin();
+        TEST_ASSERT_TRUE(Tof.Init());
+        Tof.SetThreshold(BrakeMm, HysteresisMm);
+        started = true;
+    }
+
+    Tof.SetContinuous(false);
+    Host.TofMm = 0xFFFF;
+    Mobility.SetDeadman(0, false);
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(0, 0);
+    (void)Run(2 * IdlePollMs, IdlePollMs);
+    (void)Mobility.SetObstacle(false);
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// Power
+//-----------------------------------------------------------------------------
+void test_asleep_between_slow_polls() {
+    uint32_t const rangings = Host.TofRangings;
+    uint32_t rangingMs = 0;
+    Host.TofMm = 500;
+
+    for (uint16_t i = 0; i < 10; i++) {
+        for (uint16_t ms = 0; ms < IdlePollMs; ms++) {
+            Host.Run(1);
+            if (Host.TofRanging) rangingMs++;
+        }
+        (void)Tof.Poll();
+    }
+
+    // One ranging each poll, the sensor asleep the rest of the time.
+    TEST_ASSERT_FALSE(Host.TofContinuous);
+    TEST_ASSERT_EQUAL(10, Host.TofRangings - rangings);
+    TEST_ASSERT_LESS_OR_EQUAL(10 * Host_TofRangingUs / 1000, rangingMs);
+    TEST_ASSERT_EQUAL(500, Tof.LastDistance());
+}
+
+void test_back_to_back_only_while_armed() {
+    Tof.SetContinuous(true);
+    TEST_ASSERT_TRUE(Host.TofContinuous);
+    TEST_ASSERT_EQUAL(1000000 / Host_TofRangingUs, Run(1000, ReflexPollMs));
+
+    // Disarmed, no ranging goes on without a poll.
+    Tof.SetContinuous(false);
+    TEST_ASSERT_FALSE(Host.TofContinuous);
+    uint32_t const rangings = Host.TofRangings;
+    Host.Run(5000);
+    TEST_ASSERT_EQUAL(rangings, Host.TofRangings);
+}
+
+//=============================================================================
+// Latency
+//-----------------------------------------------------------------------------
+void test_reading_time_is_the_worst_case() {
+    Host.TofMm = 500;
+    Tof.SetContinuous(true);
+
+    // However the polls fall against the rangings, the time given is never
+    // after the ranging began, and at most a poll before it.
+    for (uint16_t i = 0; i < 200; i++) {
+        Host.Run(1 + i % 7);
+
+        if (Tof.Poll()) {
+            int32_t const earlyUs = Host.TofResultUs - Tof.ReadingUs();
+            TEST_ASSERT_GREATER_OR_EQUAL(0, earlyUs);
+            TEST_ASSERT_LESS_OR_EQUAL(7000, earlyUs);
+        }
+    }
+
+    // One at a time, it is exact.
+    Tof.SetContinuous(false);
+    for (uint16_t i = 0; i < 5; i++) {
+        Host.Run(IdlePollMs);
+        if (Tof.Poll())
+            TEST_ASSERT_EQUAL(Host.TofResultUs, Tof.ReadingUs());
+    }
+}
+
+void test_brakes_within_50_ms_of_the_ranging() {
+    uint32_t worstUs = 0;
+
+    // Each approach starts a little further off, so that the wall crosses the
+    // threshold at every point of a ranging.
+    for (uint8_t approach = 0; approach < 40; approach++) {
+        float wallMm = 400 + approach * 0.5f;
+        Host.TofMm = (uint16_t)wallMm;
+        Mobility.SetDrive(100, 0);
+        Tof.SetContinuous(true);
+
+        uint32_t latencyUs = 0;
+        for (uint16_t ms = 1; ms <= 2000 && latencyUs == 0; ms++) {
+            Host.Run(1);
+            wallMm -= 0.5f;             // About a metre a second at full speed
+            Host.TofMm = (uint16_t)wallMm;
+
+            if (ms % ReflexPollMs == 0 && Tof.Poll() && Mobility.SetObstacle(Tof.IsWithinThreshold()))
+                latencyUs = micros() - Tof.ReadingUs();
+        }
+
+        TEST_ASSERT_TRUE(latencyUs > 0);
+        TEST_ASSERT_EQUAL(DRV8830_Brake, Host.Registers[Right][DRV8830_Control] & 0x03);
+        TEST_ASSERT_LESS_THAN(BrakeMm, Tof.LastDistance());
+        if (latencyUs > worstUs) worstUs = latencyUs;
+
+        // Back away and let the reflex clear.
+        Mobility.SetDrive(0, 0);
+        Tof.SetContinuous(false);
+        Host.TofMm = 0xFFFF;
+        (void)Run(2 * IdlePollMs, IdlePollMs);
+        (void)Mobility.SetObstacle(Tof.IsWithinThreshold());
+    }
+
+    // A ranging, and the poll that finds it.
+    TEST_ASSERT_LESS_OR_EQUAL(Host_TofRangingUs + ReflexPollMs * 1000, worstUs);
+    TEST_ASSERT_LESS_THAN(50000, worstUs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_asleep_between_slow_polls);
+    RUN_TEST(test_back_to_back_only_while_armed);
+    RUN_TEST(test_reading_time_is_the_worst_case);
+    RUN_TEST(test_brakes_within_50_ms_of_the_ranging);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
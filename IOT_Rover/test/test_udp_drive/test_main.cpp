@@ -0,0 +1,341 @@
+//////////////////////////////// test_main.cpp ////////////////////////////////
+// Filename:	test_main.cpp
+// Description: UdpDrive sessions, tokens and sequence numbers, over host UDP.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// test_main.cpp ////////////////////////////////
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <unity.h>
+#include <HostFakes.h>
+#include "DeviceConfig.h"			// DeviceConfig Header file
+#include "DRV8830.h"				// DRV8830 Header file
+#include "Display.h"				// Display Header file
+#include "Mobility.h"				// Mobility Header file
+#include "UdpDrive.h"				// UdpDrive Header file
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define Right       DRV8830_Addr0
+#define Left        DRV8830_Addr2
+#define VsetMin     6
+#define ClientPort  50000
+#define HalfSpeed   29          // VSET for speed 50, no steer
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static const IPAddress Client(192, 168, 1, 20);
+static const IPAddress Other(192, 168, 1, 21);
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static int8_t Output(uint8_t const addr) {
+    uint8_t const control = Host.Registers[addr][DRV8830_Control];
+    int8_t const vset = (control >> 2) - VsetMin;
+
+    switch (control & 0x03) {
+        case DRV8830_Forward: return vset;
+        case DRV8830_Reverse: return -vset;
+        default: return 0;
+    }
+}
+
+static uint8_t PutNumber(uint8_t *const packet, uint8_t length, uint32_t const value, uint8_t const bytes) {
+    for (uint8_t i = 0; i < bytes; i++)
+        packet[length++] = value >> (8 * (bytes - 1 - i));
+    return length;
+}
+
+static uint32_t GetNumber(uint8_t const *const packet, uint8_t const bytes) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++)
+        value = value << 8 | packet[i];
+    return value;
+}
+
+// Send a packet and let loop() handle it, then the control tick use it.
+static void Send(IPAddress const ip, uint16_t const port, uint8_t const *const packet, uint8_t const length) {
+    TEST_ASSERT_TRUE(Host.UdpSend(ip, port, packet, length));
+    Host.Run(Mobility_ControlPeriodMs);
+}
+
+// Start a session, returns its token.
+static uint32_t Hello(IPAddress const ip, uint16_t const port, uint32_t const clientNonce) {
+    uint8_t packet[7] = {UdpDrive_Magic0, UdpDrive_Magic1, UdpDrive_Hello};
+    Send(ip, port, packet, PutNumber(packet, 3, clientNonce, 4));
+
+    Host_Udp_t reply;
+    TEST_ASSERT_TRUE(Host.UdpReceive(&reply));
+    TEST_ASSERT_EQUAL_HEX32((uint32_t)ip, reply.Ip);
+    TEST_ASSERT_EQUAL(port, reply.Port);
+    TEST_ASSERT_EQUAL(7, reply.Length);
+    TEST_ASSERT_EQUAL(UdpDrive_Magic0, reply.Data[0]);
+    TEST_ASSERT_EQUAL(UdpDrive_Magic1, reply.Data[1]);
+    TEST_ASSERT_EQUAL_HEX8(UdpDrive_Welcome, reply.Data[2]);
+
+    return UdpDriveClass::Token(DeviceConfig.BlynkTokenNv, GetNumber(&reply.Data[3], 4), clientNonce);
+}
+
+// The magic, type, token and sequence number, then the payload.
+static uint8_t Command(uint8_t *const packet, uint8_t const type, uint32_t const token, uint16_t const seq,
+                       uint8_t const *const payload, uint8_t const count) {
+    packet[0] = UdpDrive_Magic0;
+    packet[1] = UdpDrive_Magic1;
+    packet[2] = type;
+    uint8_t const length = PutNumber(packet, PutNumber(packet, 3, token, 4), seq, 2);
+    if (count)
+        memcpy(&packet[length], payload, count);
+    return length + count;
+}
+
+static void Drive(IPAddress const ip, uint16_t const port, uint32_t const token, uint16_t const seq,
+                  int8_t const speed, int8_t const steer) {
+    uint8_t const payload[2] = {(uint8_t)speed, (uint8_t)steer};
+    uint8_t packet[UdpDrive_MaxPacket];
+    Send(ip, port, packet, Command(packet, UdpDrive_Drive, token, seq, payload, sizeof(payload)));
+}
+
+// The only reply is an Ack for seq, back to the client.
+static bool Acked(uint16_t const seq) {
+    Host_Udp_t reply;
+    if (!Host.UdpReceive(&reply))
+        return false;
+
+    TEST_ASSERT_EQUAL(5, reply.Length);
+    TEST_ASSERT_EQUAL_HEX8(UdpDrive_Ack, reply.Data[2]);
+    TEST_ASSERT_EQUAL(seq, GetNumber(&reply.Data[3], 2));
+    TEST_ASSERT_FALSE(Host.UdpReceive(&reply));
+    return true;
+}
+
+static bool NoReply() {
+    Host_Udp_t reply;
+    return !Host.UdpReceive(&reply);
+}
+
+// Begin sets the control loop timer, so it is only called once. Each test
+// starts with the link just up, no session and the rover at rest.
+void setUp() {
+    static bool started = false;
+
+    if (!started) {
+        Host.Reset();
+        Mobility.Begin();
+        UdpDrive.Begin();
+        Host.SetLoop(UdpDriveClass::Run);
+        started = true;
+    }
+
+    Host.WiFiStatus(false);
+    Host.WiFiStatus(true);
+    Mobility.SetRamp(0, 0, 0);
+    Mobility.SetDrive(0, 0);
+    Host.Run(100);
+    while (!NoReply());
+}
+
+void tearDown() {
+}
+
+//=============================================================================
+// Sessions
+//-----------------------------------------------------------------------------
+void test_drive_is_acknowledged_and_used() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+
+    Drive(Client, ClientPort, token, 1, 50, 0);
+    TEST_ASSERT_TRUE(Acked(1));
+    TEST_ASSERT_EQUAL(HalfSpeed, Output(Right));
+    TEST_ASSERT_EQUAL(HalfSpeed, Output(Left));
+}
+
+void test_wrong_token_is_dropped() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+
+    Drive(Client, ClientPort, token + 1, 1, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(0, Output(Right));
+
+    // The token from someone else's nonce is no good either.
+    Drive(Client, ClientPort, UdpDriveClass::Token(DeviceConfig.BlynkTokenNv, 0, 0x12345678), 2, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(0, Output(Right));
+}
+
+void test_other_address_is_dropped() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+
+    Drive(Other, ClientPort, token, 1, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    Drive(Client, ClientPort + 1, token, 2, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(0, Output(Right));
+
+    // Once in session the same holds.
+    Drive(Client, ClientPort, token, 3, 50, 0);
+    TEST_ASSERT_TRUE(Acked(3));
+    Drive(Other, ClientPort, token, 4, -50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(HalfSpeed, Output(Right));
+}
+
+void test_older_command_is_dropped() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+
+    Drive(Client, ClientPort, token, 10, 50, 0);
+    TEST_ASSERT_TRUE(Acked(10));
+
+    // A late packet can not undo the newer setpoint, nor a copy repeat it.
+    Drive(Client, ClientPort, token, 9, 100, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    Drive(Client, ClientPort, token, 10, 100, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(HalfSpeed, Output(Right));
+
+    Drive(Client, ClientPort, token, 12, 0, 0);
+    TEST_ASSERT_TRUE(Acked(12));
+    TEST_ASSERT_EQUAL(0, Output(Right));
+}
+
+void test_sequence_numbers_wrap() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+    static const uint16_t seqs[] = {0xFFFE, 0xFFFF, 0x0000, 0x0001};
+
+    for (uint8_t i = 0; i < sizeof(seqs) / sizeof(seqs[0]); i++) {
+        Drive(Client, ClientPort, token, seqs[i], 50, 0);
+        TEST_ASSERT_TRUE(Acked(seqs[i]));
+    }
+
+    Drive(Client, ClientPort, token, 0xFFFF, 0, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(HalfSpeed, Output(Right));
+}
+
+void test_new_hello_waits_for_its_first_command() {
+    uint32_t const first = Hello(Client, ClientPort, 0x12345678);
+    Drive(Client, ClientPort, first, 5, 50, 0);
+    TEST_ASSERT_TRUE(Acked(5));
+
+    // A stray Hello does not cut off the driver.
+    uint32_t const second = Hello(Other, ClientPort, 0x9ABCDEF0);
+    Drive(Client, ClientPort, first, 6, 50, 0);
+    TEST_ASSERT_TRUE(Acked(6));
+
+    // Its first good command takes over, with its own sequence numbers.
+    Drive(Other, ClientPort, second, 1, -50, 0);
+    TEST_ASSERT_TRUE(Acked(1));
+    Host.Run(Mobility_ControlPeriodMs);     // Rests a tick through zero
+    TEST_ASSERT_EQUAL(-HalfSpeed, Output(Right));
+
+    Drive(Client, ClientPort, first, 7, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(-HalfSpeed, Output(Right));
+}
+
+//=============================================================================
+// Commands
+//-----------------------------------------------------------------------------
+void test_text_is_shown() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+    uint8_t packet[UdpDrive_MaxPacket];
+    Display.SetMode(Display_TEMPORARY_Show, Display_U64_Mode);
+
+    // The count must match the characters sent.
+    uint8_t const bad[] = {3, 'H', 'i'};
+    Send(Client, ClientPort, packet, Command(packet, UdpDrive_Text, token, 1, bad, sizeof(bad)));
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(Display_U64_Mode, Display.GetMode(Display_TEMPORARY_Show));
+
+    uint8_t const text[] = {2, 'H', 'i'};
+    Send(Client, ClientPort, packet, Command(packet, UdpDrive_Text, token, 2, text, sizeof(text)));
+    TEST_ASSERT_TRUE(Acked(2));
+    TEST_ASSERT_EQUAL(Display_String_Mode, Display.GetMode(Display_TEMPORARY_Show));
+}
+
+void test_stop_brakes() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+    uint8_t packet[UdpDrive_MaxPacket];
+
+    Drive(Client, ClientPort, token, 1, 50, 0);
+    TEST_ASSERT_TRUE(Acked(1));
+
+    Send(Client, ClientPort, packet, Command(packet, UdpDrive_Stop, token, 2, NULL, 0));
+    TEST_ASSERT_TRUE(Acked(2));
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Host.Registers[Right][DRV8830_Control] & 0x03);
+    TEST_ASSERT_EQUAL(DRV8830_Brake, Host.Registers[Left][DRV8830_Control] & 0x03);
+}
+
+void test_malformed_packets_are_dropped() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+    uint8_t packet[UdpDrive_MaxPacket];
+    uint8_t const payload[3] = {50, 0, 0};
+
+    // Wrong magic.
+    uint8_t length = Command(packet, UdpDrive_Drive, token, 1, payload, 2);
+    packet[0] = 'X';
+    Send(Client, ClientPort, packet, length);
+    TEST_ASSERT_TRUE(NoReply());
+
+    // Drive with a byte missing, and one too many.
+    Send(Client, ClientPort, packet, Command(packet, UdpDrive_Drive, token, 2, payload, 1));
+    TEST_ASSERT_TRUE(NoReply());
+    Send(Client, ClientPort, packet, Command(packet, UdpDrive_Drive, token, 3, payload, 3));
+    TEST_ASSERT_TRUE(NoReply());
+
+    // An unknown type, and a Hello without its nonce.
+    Send(Client, ClientPort, packet, Command(packet, 0x7F, token, 4, payload, 2));
+    TEST_ASSERT_TRUE(NoReply());
+    Send(Client, ClientPort, packet, 3);
+    TEST_ASSERT_TRUE(NoReply());
+
+    TEST_ASSERT_EQUAL(0, Output(Right));
+
+    // None of them used up a sequence number.
+    Drive(Client, ClientPort, token, 1, 50, 0);
+    TEST_ASSERT_TRUE(Acked(1));
+}
+
+//=============================================================================
+// Link
+//-----------------------------------------------------------------------------
+void test_nothing_while_wifi_is_down() {
+    uint32_t const token = Hello(Client, ClientPort, 0x12345678);
+    uint8_t packet[UdpDrive_MaxPacket];
+    uint8_t const payload[2] = {50, 0};
+
+    Host.WiFiStatus(false);
+    TEST_ASSERT_FALSE(Host.UdpSend(Client, ClientPort, packet,
+                                   Command(packet, UdpDrive_Drive, token, 1, payload, sizeof(payload))));
+
+    // Back up, the old session is gone and a new Hello is needed.
+    Host.WiFiStatus(true);
+    Drive(Client, ClientPort, token, 2, 50, 0);
+    TEST_ASSERT_TRUE(NoReply());
+    TEST_ASSERT_EQUAL(0, Output(Right));
+
+    uint32_t const again = Hello(Client, ClientPort, 0x12345679);
+    Drive(Client, ClientPort, again, 1, 50, 0);
+    TEST_ASSERT_TRUE(Acked(1));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_drive_is_acknowledged_and_used);
+    RUN_TEST(test_wrong_token_is_dropped);
+    RUN_TEST(test_other_address_is_dropped);
+    RUN_TEST(test_older_command_is_dropped);
+    RUN_TEST(test_sequence_numbers_wrap);
+    RUN_TEST(test_new_hello_waits_for_its_first_command);
+    RUN_TEST(test_text_is_shown);
+    RUN_TEST(test_stop_brakes);
+    RUN_TEST(test_malformed_packets_are_dropped);
+    RUN_TEST(test_nothing_while_wifi_is_down);
+    return UNITY_END();
+}
+
+// test_main.cpp EOF
@@ -0,0 +1,193 @@
+//////////////////////////////// FontGen.cpp //////////////////////////////////
+// Filename:	FontGen.cpp
+// Description: Host tool, convert AsciiArray into the proportional display font.
+// Author:		Danon Bradford
+// Date:		2020-04-04
+//////////////////////////////// FontGen.cpp //////////////////////////////////
+//
+// Build and run on the PC, from the IOT_Rover directory:
+//   g++ -std=c++11 -O2 -o FontGen tools/FontGen.cpp
+//   ./FontGen -k > include/FontData.h
+//
+// Options:
+//   -k      Turn on kerning. The firmware moves a glyph one column closer when
+//           the facing edge columns of the pair do not touch, so no pair
+//           table is stored.
+//   -s N    Columns the scroll moves for a space or a missing glyph (default 3).
+//
+// Every non blank glyph is trimmed to the columns it uses. The columns are
+// stored one byte each, bit n is row n. The left bearing is kept, so that the
+// full 8x8 image can still be rebuilt for portrait scrolling.
+// All the tables are PROGMEM and read a 32 bit word at a time.
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "AsciiArray.h"				// The fixed 8x8 source font
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define GlyphCount      256
+#define Spacing         1           // Blank columns after every glyph
+
+//*****************************************************************************
+// Private Structure's & Type Definitions
+//-----------------------------------------------------------------------------
+typedef struct {
+    uint8_t Left;                   // First used column
+    uint8_t Width;                  // Used columns, 0 for a blank glyph
+    uint8_t Columns[8];
+} Glyph_t;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static void Trim(uint64_t const image, Glyph_t *const glyph) {
+    uint8_t all = 0;
+    uint8_t columns[8] = {0};
+
+    // Byte n of the image is row n, bit n of a row is column n.
+    for (uint8_t row = 0; row < 8; row++) {
+        uint8_t const bits = image >> (row * 8);
+        all |= bits;
+
+        for (uint8_t col = 0; col < 8; col++) {
+            if (bits & (1u << col))
+                columns[col] |= 1u << row;
+        }
+    }
+
+    memset(glyph, 0, sizeof(*glyph));
+
+    if (all == 0)
+        return;
+
+    uint8_t first = 0;
+    uint8_t last = 7;
+    while (!(all & (1u << first))) first++;
+    while (!(all & (1u << last))) last--;
+
+    glyph->Left = first;
+    glyph->Width = last - first + 1;
+    memcpy(glyph->Columns, &columns[first], glyph->Width);
+}
+
+static const char* Name(int const code) {
+    static char name[8];
+
+    if (code == '\\')
+        return "back slash";
+
+    if (code > 32 && code < 127) {
+        name[0] = (char)code;
+        name[1] = 0;
+    } else {
+        snprintf(name, sizeof(name), "0x%02X", code);
+    }
+    return name;
+}
+
+//*****************************************************************************
+// Main
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    bool kerning = false;
+    int spaceAdvance = 3;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-k") == 0) {
+            kerning = true;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            spaceAdvance = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-k] [-s spaceAdvance]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    static Glyph_t glyphs[GlyphCount];
+    for (int code = 0; code < GlyphCount; code++)
+        Trim(AsciiArray[code], &glyphs[code]);
+
+    // Group the non blank code points into ranges.
+    std::vector<int> rangeFirst, rangeCount, rangeGlyph;
+    int glyphTotal = 0;
+    for (int code = 0; code < GlyphCount; code++) {
+        if (glyphs[code].Width == 0)
+            continue;
+
+        if (rangeFirst.empty() || rangeFirst.back() + rangeCount.back() != code) {
+            rangeFirst.push_back(code);
+            rangeCount.push_back(0);
+            rangeGlyph.push_back(glyphTotal);
+        }
+        rangeCount.back()++;
+        glyphTotal++;
+    }
+
+    int columnTotal = 0;
+    for (int code = 0; code < GlyphCount; code++)
+        columnTotal += glyphs[code].Width;
+
+    printf("//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH FontData.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH\n");
+    printf("// Filename:	FontData.h\n");
+    printf("// Description: Proportional display font, made by tools/FontGen.cpp. Do not edit.\n");
+    printf("//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHH FontData.h HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH\n\n");
+    printf("#ifndef FontData_h\n#define FontData_h\n\n");
+    printf("#include \"Font.h\"					// Font Header file\n\n");
+    printf("// %d glyphs, %d column bytes, %d ranges.\n", glyphTotal, columnTotal, (int)rangeFirst.size());
+    printf("#define Font_GlyphCount     %d\n", glyphTotal);
+    printf("#define Font_RangeCount     %d\n", (int)rangeFirst.size());
+    printf("#define Font_Kerning        %d\n", kerning ? 1 : 0);
+    printf("#define Font_Spacing        %d\n", Spacing);
+    printf("#define Font_SpaceAdvance   %d\n\n", spaceAdvance);
+
+    // Column data, in flash. It is padded so that the three 32 bit words
+    // covering any glyph can be read without going past the end.
+    int const columnPadded = ((columnTotal + 3) & ~3) + 8;
+    printf("#define Font_ColumnBytes    %d\n\n", columnPadded);
+    printf("const uint8_t FontColumns[Font_ColumnBytes] PROGMEM __attribute__((aligned(4))) = {\n");
+    for (int code = 0; code < GlyphCount; code++) {
+        if (glyphs[code].Width == 0)
+            continue;
+
+        printf("   ");
+        for (int i = 0; i < glyphs[code].Width; i++)
+            printf(" 0x%02x,", glyphs[code].Columns[i]);
+        printf("%*s// %3d = %s\n", (8 - glyphs[code].Width) * 6 + 8, "", code, Name(code));
+    }
+    printf("};\n\n");
+
+    // Glyph table, in code point order, one word per glyph.
+    printf("// Column offset in bits 0-15, width in bits 16-19, left bearing in bits 20-23.\n");
+    printf("const uint32_t FontGlyphs[Font_GlyphCount] PROGMEM = {\n");
+    int offset = 0;
+    for (int code = 0; code < GlyphCount; code++) {
+        if (glyphs[code].Width == 0)
+            continue;
+
+        printf("    0x%08x,                         // %3d = %s\n",
+               offset | (glyphs[code].Width << 16) | (glyphs[code].Left << 20), code, Name(code));
+        offset += glyphs[code].Width;
+    }
+    printf("};\n\n");
+
+    printf("// First code point in bits 0-7, count in bits 8-15, first glyph in bits 16-23.\n");
+    printf("const uint32_t FontRanges[Font_RangeCount] PROGMEM = {\n");
+    for (size_t i = 0; i < rangeFirst.size(); i++)
+        printf("    0x%08x,                         // %3d - %3d\n",
+               rangeFirst[i] | (rangeCount[i] << 8) | (rangeGlyph[i] << 16),
+               rangeFirst[i], rangeFirst[i] + rangeCount[i] - 1);
+    printf("};\n\n");
+
+    printf("#endif /* FontData_h */\n\n// FontData.h EOF\n");
+
+    return 0;
+}
+
+// FontGen.cpp EOF
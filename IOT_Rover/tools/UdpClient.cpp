@@ -0,0 +1,256 @@
+//////////////////////////////// UdpClient.cpp ////////////////////////////////
+// Filename:	UdpClient.cpp
+// Description: Host tool, drive the rover over UDP and time the round trips.
+// Author:		Danon Bradford
+// Date:		2020-05-23
+//////////////////////////////// UdpClient.cpp ////////////////////////////////
+//
+// Build and run on the PC, from the IOT_Rover directory:
+//   g++ -std=c++11 -O2 -Iinclude -o UdpClient tools/UdpClient.cpp
+//   ./UdpClient [options] <rover ip> <blynk auth token>
+//
+// Options:
+//   -n N    Drive packets to send (default 200).
+//   -i MS   Time between packets (default 50).
+//   -s N    Speed to drive at, -100 to 100 (default 0, the rover stays put).
+//   -t N    Steer, -100 to 100 (default 0).
+//   -m TEXT Show the text on the display first.
+//   -x      Send every tenth pair of packets the wrong way around, to check
+//           the older one is dropped. Each adds a 50 ms wait.
+//   -p N    UDP port (default UdpDrive_Port).
+//
+// Starts a session, sends the drive packets at the interval and times each
+// one to its Ack. A packet with no Ack in 500 ms is counted as lost. Ends
+// with a zero setpoint so the rover is left stopped. tools/UdpRover.cpp runs
+// the rover end on the PC, to try it without one.
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "UdpDrive.h"				// The packet format and session token
+
+//*****************************************************************************
+// Private Macro Definitions
+//-----------------------------------------------------------------------------
+#define AckTimeoutMs    500
+#define DropWaitMs      50          // Wait for an Ack that should not come
+#define HelloTries      3
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static int Socket = -1;
+static uint32_t SessionToken = 0;
+static uint16_t Seq = 0;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static double NowMs() {
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::milli>>(steady_clock::now().time_since_epoch()).count();
+}
+
+static uint8_t PutNumber(uint8_t *const packet, uint8_t length, uint32_t const value, uint8_t const bytes) {
+    for (uint8_t i = 0; i < bytes; i++)
+        packet[length++] = value >> (8 * (bytes - 1 - i));
+    return length;
+}
+
+static uint32_t GetNumber(uint8_t const *const packet, uint8_t const bytes) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++)
+        value = value << 8 | packet[i];
+    return value;
+}
+
+// Wait for a reply of one type, up to a time. Returns its length, 0 on timeout.
+static int Receive(uint8_t const type, uint8_t *const packet, double const untilMs) {
+    for (;;) {
+        double const leftMs = untilMs - NowMs();
+        if (leftMs <= 0)
+            return 0;
+
+        struct timeval timeout;
+        timeout.tv_sec = (long)leftMs / 1000;
+        timeout.tv_usec = ((long)(leftMs * 1000)) % 1000000;
+        setsockopt(Socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        ssize_t const length = recv(Socket, packet, UdpDrive_MaxPacket, 0);
+        if (length >= 3 && packet[0] == UdpDrive_Magic0 && packet[1] == UdpDrive_Magic1 && packet[2] == type)
+            return (int)length;
+    }
+}
+
+// The magic, type, token and next sequence number.
+static uint8_t Command(uint8_t *const packet, uint8_t const type) {
+    packet[0] = UdpDrive_Magic0;
+    packet[1] = UdpDrive_Magic1;
+    packet[2] = type;
+    uint8_t const length = PutNumber(packet, 3, SessionToken, 4);
+    return PutNumber(packet, length, ++Seq, 2);
+}
+
+static uint8_t Drive(uint8_t *const packet, int8_t const speed, int8_t const steer) {
+    uint8_t length = Command(packet, UdpDrive_Drive);
+    packet[length++] = speed;
+    packet[length++] = steer;
+    return length;
+}
+
+static bool Hello(const char *auth) {
+    uint8_t packet[UdpDrive_MaxPacket] = {UdpDrive_Magic0, UdpDrive_Magic1, UdpDrive_Hello};
+    srand((unsigned)time(NULL) ^ (unsigned)getpid());
+    uint32_t const clientNonce = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+
+    for (int tries = 0; tries < HelloTries; tries++) {
+        send(Socket, packet, PutNumber(packet, 3, clientNonce, 4), 0);
+
+        uint8_t reply[UdpDrive_MaxPacket];
+        if (Receive(UdpDrive_Welcome, reply, NowMs() + AckTimeoutMs) == 7) {
+            SessionToken = UdpDriveClass::Token(auth, GetNumber(&reply[3], 4), clientNonce);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Send a command and wait for its Ack. Returns the round trip in ms, or -1.
+static double RoundTrip(uint8_t const *const packet, uint8_t const length, double const timeoutMs = AckTimeoutMs) {
+    uint16_t const seq = GetNumber(&packet[7], 2);
+    double const startMs = NowMs();
+    uint8_t reply[UdpDrive_MaxPacket];
+
+    send(Socket, packet, length, 0);
+
+    while (Receive(UdpDrive_Ack, reply, startMs + timeoutMs) == 5)
+        if (GetNumber(&reply[3], 2) == seq)
+            return NowMs() - startMs;
+
+    return -1;
+}
+
+static double Percentile(std::vector<double> const &sorted, double const percent) {
+    size_t const index = (size_t)(percent / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+int main(int argc, char **argv) {
+    int count = 200;
+    int intervalMs = 50;
+    int speed = 0;
+    int steer = 0;
+    int port = UdpDrive_Port;
+    const char *text = NULL;
+    bool swap = false;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:i:s:t:m:p:x")) != -1) {
+        switch (option) {
+            case 'n': count = atoi(optarg); break;
+            case 'i': intervalMs = atoi(optarg); break;
+            case 's': speed = std::max(-100, std::min(100, atoi(optarg))); break;
+            case 't': steer = std::max(-100, std::min(100, atoi(optarg))); break;
+            case 'm': text = optarg; break;
+            case 'p': port = atoi(optarg); break;
+            case 'x': swap = true; break;
+            default: return 1;
+        }
+    }
+
+    if (argc - optind != 2) {
+        fprintf(stderr, "Usage: %s [-n count] [-i ms] [-s speed] [-t steer] [-m text] [-x] [-p port] <rover ip> <blynk auth token>\n", argv[0]);
+        return 1;
+    }
+
+    struct sockaddr_in rover;
+    memset(&rover, 0, sizeof(rover));
+    rover.sin_family = AF_INET;
+    rover.sin_port = htons(port);
+    if (inet_pton(AF_INET, argv[optind], &rover.sin_addr) != 1) {
+        fprintf(stderr, "Not an IP address: %s\n", argv[optind]);
+        return 1;
+    }
+
+    Socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Socket < 0 || connect(Socket, (struct sockaddr *)&rover, sizeof(rover)) != 0) {
+        perror("socket");
+        return 1;
+    }
+
+    if (!Hello(argv[optind + 1])) {
+        fprintf(stderr, "No Welcome from %s:%d\n", argv[optind], port);
+        return 1;
+    }
+
+    uint8_t packet[UdpDrive_MaxPacket];
+    uint8_t length;
+
+    if (text) {
+        uint8_t const characters = std::min(strlen(text), (size_t)UdpDrive_MaxText);
+        length = Command(packet, UdpDrive_Text);
+        packet[length++] = characters;
+        memcpy(&packet[length], text, characters);
+        printf("Text: %s\n", RoundTrip(packet, length + characters) < 0 ? "lost" : "shown");
+    }
+
+    std::vector<double> trips;
+    int lost = 0;
+    int swapped = 0;
+    int swapAcked = 0;
+    double nextMs = NowMs();
+
+    for (int i = 0; i < count; i++) {
+        // The newer packet first, then the older one, which should be dropped.
+        if (swap && i % 10 == 9) {
+            uint8_t older[UdpDrive_MaxPacket];
+            uint8_t const olderLength = Drive(older, speed, steer);
+            length = Drive(packet, speed, steer);
+            double const tripMs = RoundTrip(packet, length);
+            swapped++;
+            if (RoundTrip(older, olderLength, DropWaitMs) >= 0)
+                swapAcked++;
+            if (tripMs >= 0) trips.push_back(tripMs); else lost++;
+        } else {
+            length = Drive(packet, speed, steer);
+            double const tripMs = RoundTrip(packet, length);
+            if (tripMs >= 0) trips.push_back(tripMs); else lost++;
+        }
+
+        nextMs += intervalMs;
+        double const waitMs = nextMs - NowMs();
+        if (waitMs > 0)
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(waitMs));
+    }
+
+    length = Drive(packet, 0, 0);
+    bool const stopped = RoundTrip(packet, length) >= 0;
+
+    printf("%d sent, %d acknowledged, %d lost\n", count, (int)trips.size(), lost);
+    if (!trips.empty()) {
+        std::sort(trips.begin(), trips.end());
+        printf("Round trip ms: min %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+               trips.front(), Percentile(trips, 50), Percentile(trips, 90), Percentile(trips, 99), trips.back());
+    }
+    if (swap)
+        printf("Out of order: %d sent, %d wrongly acknowledged\n", swapped, swapAcked);
+    if (!stopped)
+        printf("The final stop was not acknowledged\n");
+
+    close(Socket);
+    return lost || swapAcked || !stopped ? 2 : 0;
+}
+
+// UdpClient.cpp EOF
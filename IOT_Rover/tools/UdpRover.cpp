@@ -0,0 +1,156 @@
+//////////////////////////////// UdpRover.cpp /////////////////////////////////
+// Filename:	UdpRover.cpp
+// Description: Host tool, the rover's UdpDrive and Mobility on a PC socket.
+// Author:		Danon Bradford
+// Date:		2020-05-30
+//////////////////////////////// UdpRover.cpp /////////////////////////////////
+//
+// Build and run on the PC, from the IOT_Rover directory:
+//   g++ -std=gnu++11 -O2 -Iinclude -Ilib/HostFakes/src -o UdpRover tools/UdpRover.cpp
+//       src/I2CBus.cpp src/LightGrid.cpp src/Font.cpp src/Format.cpp src/Display.cpp
+//       src/DRV8830.cpp src/Mobility.cpp src/Odometry.cpp src/DriveScript.cpp
+//       src/UdpDrive.cpp src/Distance.cpp lib/HostFakes/src/HostFakes.cpp
+//   ./UdpRover [options]
+//
+// Options:
+//   -a IP   Address to listen on (default 127.0.0.1).
+//   -p N    UDP port (default UdpDrive_Port).
+//   -k KEY  The Blynk auth token the session token is made from
+//           (default the HostFakes token, printed at the start).
+//   -d S    Seconds to run for (default 30).
+//
+// The firmware sources are built as for the native unit tests, on the
+// HostFakes stand-ins, with the host clock kept to the wall clock. Packets
+// from the socket go into the HostFakes WiFiUDP queue and loop() is run at
+// once, as the rover's loop() would find them. Replies go straight back out
+// of the socket. Drive tools/UdpClient.cpp at it to time the round trips:
+//   ./UdpRover -d 20 &
+//   ./UdpClient -n 1000 -i 5 127.0.0.1 HostBlynkAuthToken
+// The motor outputs are not driven, they are only the fake DRV8830 registers.
+
+//IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+// Header Files
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <HostFakes.h>
+#include "DeviceConfig.h"			// DeviceConfig Header file
+#include "Mobility.h"				// Mobility Header file
+#include "UdpDrive.h"				// UdpDrive Header file
+
+//*****************************************************************************
+// Private Global Variables
+//-----------------------------------------------------------------------------
+static int Socket = -1;
+
+//*****************************************************************************
+// Private Function Definitions
+//-----------------------------------------------------------------------------
+static uint32_t WallMs() {
+    using namespace std::chrono;
+    static steady_clock::time_point const start = steady_clock::now();
+    return duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+
+// IPAddress keeps the first octet in the low byte, as s_addr does on a little endian PC.
+static void Receive() {
+    uint8_t data[Host_UdpMaxBytes + 1];
+    sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    ssize_t length;
+
+    while ((length = recvfrom(Socket, data, sizeof(data), MSG_DONTWAIT, (sockaddr*)&from, &fromLength)) >= 0) {
+        if (length <= Host_UdpMaxBytes)
+            (void)Host.UdpSend(IPAddress(from.sin_addr.s_addr), ntohs(from.sin_port), data, length);
+        fromLength = sizeof(from);
+    }
+}
+
+static void Reply() {
+    Host_Udp_t packet;
+
+    while (Host.UdpReceive(&packet)) {
+        sockaddr_in to;
+        memset(&to, 0, sizeof(to));
+        to.sin_family = AF_INET;
+        to.sin_addr.s_addr = packet.Ip;
+        to.sin_port = htons(packet.Port);
+        (void)sendto(Socket, packet.Data, packet.Length, 0, (sockaddr*)&to, sizeof(to));
+    }
+}
+
+static void Usage() {
+    fprintf(stderr, "usage: UdpRover [-a ip] [-p port] [-k blynk auth token] [-d seconds]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *address = "127.0.0.1";
+    uint16_t port = UdpDrive_Port;
+    uint32_t seconds = 30;
+    int option;
+
+    while ((option = getopt(argc, argv, "a:p:k:d:")) != -1) {
+        switch (option) {
+            case 'a': address = optarg; break;
+            case 'p': port = atoi(optarg); break;
+            case 'k': DeviceConfig.BlynkTokenNv = optarg; break;
+            case 'd': seconds = atoi(optarg); break;
+            default: Usage();
+        }
+    }
+
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+
+    Socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Socket < 0 || inet_pton(AF_INET, address, &local.sin_addr) != 1 ||
+        bind(Socket, (sockaddr*)&local, sizeof(local)) != 0) {
+        perror("UdpRover");
+        return 1;
+    }
+
+    // The rover as it is once the station is connected, Serial to the console.
+    Host.Echo = true;
+    Host.Reset();
+    Mobility.Begin();
+    UdpDrive.Begin();
+    Host.SetLoop(UdpDriveClass::Run);
+    Host.WiFiStatus(true);
+    printf("Listening on %s:%u, token %s, for %u s\n", address, port, DeviceConfig.BlynkTokenNv, seconds);
+    fflush(stdout);
+
+    uint32_t hostMs = 0;
+
+    while (hostMs < seconds * 1000) {
+        pollfd waiting = {Socket, POLLIN, 0};
+
+        if (poll(&waiting, 1, 1) > 0) {
+            Receive();
+            UdpDriveClass::Run();
+            Reply();
+        }
+
+        // The timers and loop() catch up with the wall clock a ms at a time.
+        for (uint32_t const wallMs = WallMs(); hostMs < wallMs; hostMs++) {
+            Host.Run(1);
+            Reply();
+        }
+    }
+
+    UdpDrive.PrintStats();
+    Mobility.PrintControlStats();
+    Mobility.PrintWriteStats();
+    close(Socket);
+    return 0;
+}
+
+// UdpRover.cpp EOF